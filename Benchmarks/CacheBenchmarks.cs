@@ -0,0 +1,70 @@
+using BenchmarkDotNet.Attributes;
+using ProjetoSimuladorPC.Cache;
+
+namespace ProjetoSimuladorPC.Benchmarks
+{
+    /// <summary>
+    /// Cache.Access em várias geometrias e políticas. Cada invocação percorre um fluxo fixo de
+    /// endereços (metade sequencial, metade aleatória sobre 4x o tamanho da cache) com 25% de escritas.
+    /// </summary>
+    [Config(typeof(ConfiguracaoBenchmarks))]
+    public class CacheBenchmarks
+    {
+        const int Acessos = 4096;
+
+        [Params(4 * 1024, 64 * 1024)]
+        public int TamanhoBytes { get; set; }
+
+        [Params(32, 64)]
+        public int Linha { get; set; }
+
+        [Params(1, 4, 16)]
+        public int Associatividade { get; set; }
+
+        [Params(ReplacementPolicy.LRU, ReplacementPolicy.FIFO)]
+        public ReplacementPolicy Substituicao { get; set; }
+
+        [Params(WritePolicy.WriteThrough, WritePolicy.WriteBack)]
+        public WritePolicy Escrita { get; set; }
+
+        Cache.Cache cache = null!;
+        uint[] enderecos = null!;
+        bool[] escritas = null!;
+
+        [GlobalSetup]
+        public void Preparar()
+        {
+            cache = new Cache.Cache(TamanhoBytes, Linha, Associatividade, Substituicao, Escrita, new CacheState());
+            cache.SincronizarFachada = false;
+
+            var rnd = new Random(42);
+            enderecos = new uint[Acessos];
+            escritas = new bool[Acessos];
+            for (int i = 0; i < Acessos; i++)
+            {
+                enderecos[i] = i < Acessos / 2 ? (uint)(i * 4) : (uint)rnd.Next(TamanhoBytes * 4);
+                escritas[i] = rnd.Next(4) == 0;
+            }
+        }
+
+        [Benchmark(OperationsPerInvoke = Acessos)]
+        public void Access()
+        {
+            var c = cache;
+            var end = enderecos;
+            var esc = escritas;
+            for (int i = 0; i < end.Length; i++) c.Access(end[i], esc[i]);
+        }
+
+        /// <summary>
+        /// Mesmo fluxo sincronizando a fachada CacheState a cada acesso (modo interativo da UI).
+        /// </summary>
+        [Benchmark(OperationsPerInvoke = Acessos)]
+        public void AccessComFachada()
+        {
+            cache.SincronizarFachada = true;
+            try { Access(); }
+            finally { cache.SincronizarFachada = false; }
+        }
+    }
+}
@@ -0,0 +1,110 @@
+using System.Globalization;
+using System.Text.Json;
+
+namespace ProjetoSimuladorPC.Benchmarks
+{
+    /// <summary>
+    /// Compara os relatórios JSON do BenchmarkDotNet (<c>*-report-full.json</c>) de uma execução
+    /// com os guardados em Baselines/. Regressões de ops/s ou de bytes alocados por operação
+    /// acima da tolerância são listadas e fazem o processo terminar com código 1.
+    /// </summary>
+    public static class ComparadorBaseline
+    {
+        const string PadraoRelatorio = "*-report-full.json";
+
+        public record Medida(string Nome, double MediaNs, long? BytesPorOperacao)
+        {
+            public double OpsPorSegundo => MediaNs > 0 ? 1e9 / MediaNs : 0;
+        }
+
+        /// <summary>
+        /// Copia os relatórios de <paramref name="resultados"/> para <paramref name="baselines"/>.
+        /// </summary>
+        public static int SalvarBaseline(string resultados, string baselines)
+        {
+            var arquivos = Directory.Exists(resultados) ? Directory.GetFiles(resultados, PadraoRelatorio) : Array.Empty<string>();
+            if (arquivos.Length == 0)
+            {
+                Console.Error.WriteLine($"Nenhum relatório {PadraoRelatorio} em {resultados}.");
+                return 2;
+            }
+
+            Directory.CreateDirectory(baselines);
+            foreach (var arquivo in arquivos)
+            {
+                File.Copy(arquivo, Path.Combine(baselines, Path.GetFileName(arquivo)), overwrite: true);
+                Console.WriteLine($"baseline: {Path.GetFileName(arquivo)}");
+            }
+            return 0;
+        }
+
+        /// <summary>
+        /// Imprime a variação de cada benchmark presente nos dois conjuntos e retorna 1 se houver
+        /// regressão além de <paramref name="tolerancia"/> (fração, ex.: 0,10 = 10%).
+        /// </summary>
+        public static int Comparar(string baselines, string resultados, double tolerancia)
+        {
+            var antes = Carregar(baselines);
+            var depois = Carregar(resultados);
+            if (antes.Count == 0 || depois.Count == 0)
+            {
+                Console.Error.WriteLine($"Sem relatórios para comparar (baseline: {antes.Count}, atual: {depois.Count}).");
+                return 2;
+            }
+
+            int regressoes = 0;
+            Console.WriteLine($"{"Benchmark",-90} {"ops/s base",14} {"ops/s atual",14} {"Δ ops",8} {"B/op base",10} {"B/op atual",10}");
+            foreach (var atual in depois.Values.OrderBy(m => m.Nome, StringComparer.Ordinal))
+            {
+                if (!antes.TryGetValue(atual.Nome, out var referencia))
+                {
+                    Console.WriteLine($"{atual.Nome,-90} {"(novo)",14} {atual.OpsPorSegundo,14:N0}");
+                    continue;
+                }
+
+                double delta = referencia.OpsPorSegundo > 0 ? atual.OpsPorSegundo / referencia.OpsPorSegundo - 1 : 0;
+                bool regrediuTempo = delta < -tolerancia;
+                // alocação: qualquer aumento a partir de zero conta; fora isso vale a tolerância
+                bool regrediuMemoria = atual.BytesPorOperacao is long b && referencia.BytesPorOperacao is long b0
+                    && (b0 == 0 ? b > 0 : b > b0 * (1 + tolerancia));
+
+                string marca = regrediuTempo || regrediuMemoria ? "  << REGRESSÃO" : string.Empty;
+                if (marca.Length > 0) regressoes++;
+
+                Console.WriteLine(string.Create(CultureInfo.InvariantCulture,
+                    $"{atual.Nome,-90} {referencia.OpsPorSegundo,14:N0} {atual.OpsPorSegundo,14:N0} {delta,8:P1} {Bytes(referencia.BytesPorOperacao),10} {Bytes(atual.BytesPorOperacao),10}{marca}"));
+            }
+
+            Console.WriteLine(regressoes == 0 ? "Nenhuma regressão." : $"{regressoes} regressão(ões) acima de {tolerancia:P0}.");
+            return regressoes == 0 ? 0 : 1;
+        }
+
+        static string Bytes(long? b) => b?.ToString(CultureInfo.InvariantCulture) ?? "-";
+
+        // lê todos os relatórios de um diretório, indexados pelo nome completo (inclui parâmetros)
+        static Dictionary<string, Medida> Carregar(string diretorio)
+        {
+            var medidas = new Dictionary<string, Medida>(StringComparer.Ordinal);
+            if (!Directory.Exists(diretorio)) return medidas;
+
+            foreach (var arquivo in Directory.GetFiles(diretorio, PadraoRelatorio))
+            {
+                using var doc = JsonDocument.Parse(File.ReadAllBytes(arquivo));
+                if (!doc.RootElement.TryGetProperty("Benchmarks", out var benchmarks)) continue;
+
+                foreach (var b in benchmarks.EnumerateArray())
+                {
+                    if (!b.TryGetProperty("FullName", out var nome)) continue;
+                    if (!b.TryGetProperty("Statistics", out var estat) || estat.ValueKind != JsonValueKind.Object) continue;
+
+                    long? bytes = null;
+                    if (b.TryGetProperty("Memory", out var mem) && mem.TryGetProperty("BytesAllocatedPerOperation", out var bpo))
+                        bytes = bpo.GetInt64();
+
+                    medidas[nome.GetString()!] = new Medida(nome.GetString()!, estat.GetProperty("Mean").GetDouble(), bytes);
+                }
+            }
+            return medidas;
+        }
+    }
+}
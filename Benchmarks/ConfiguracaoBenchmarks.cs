@@ -0,0 +1,25 @@
+using BenchmarkDotNet.Columns;
+using BenchmarkDotNet.Configs;
+using BenchmarkDotNet.Diagnosers;
+using BenchmarkDotNet.Exporters;
+using BenchmarkDotNet.Exporters.Json;
+
+namespace ProjetoSimuladorPC.Benchmarks
+{
+    /// <summary>
+    /// Configuração comum a todas as suítes: diagnóstico de memória (bytes alocados por operação)
+    /// e exportação JSON completa, que é o formato guardado em Baselines/ e lido por
+    /// <see cref="ComparadorBaseline"/>.
+    /// </summary>
+    public class ConfiguracaoBenchmarks : ManualConfig
+    {
+        public ConfiguracaoBenchmarks()
+        {
+            AddDiagnoser(MemoryDiagnoser.Default);
+            AddExporter(JsonExporter.Full);
+            AddExporter(MarkdownExporter.GitHub);
+            AddColumn(StatisticColumn.OperationsPerSecond);
+            WithOptions(ConfigOptions.JoinSummary);
+        }
+    }
+}
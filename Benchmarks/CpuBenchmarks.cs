@@ -0,0 +1,57 @@
+using BenchmarkDotNet.Attributes;
+using ProjetoSimIO.Core;
+using ProjetoSimuladorPC.Cache;
+using ProjetoSimuladorPC.Cpu;
+using ProjetoSimuladorPC.RAM;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Benchmarks
+{
+    /// <summary>
+    /// InstructionExecutor.ExecuteNextInstruction e CpuSimulator.Tick sobre RAM de 1 MB com a
+    /// cache padrão anexada. O PC volta ao início antes de sair da RAM (a CPU nunca entra em FAULT).
+    /// </summary>
+    [Config(typeof(ConfiguracaoBenchmarks))]
+    public class CpuBenchmarks
+    {
+        const int Instrucoes = 1024;
+
+        RamState ram = null!;
+        CpuState estado = null!;
+        InstructionExecutor executor = null!;
+        CpuSimulator cpu = null!;
+        PicController pic = null!;
+        int limitePc;
+
+        [GlobalSetup]
+        public void Preparar()
+        {
+            ram = new RamState(1);
+            ram.AttachCache(new Cache.Cache(16 * 1024, 64, 2, ReplacementPolicy.LRU, WritePolicy.WriteThrough) { SincronizarFachada = false });
+            var programa = new byte[ram.TamanhoEmBytes];
+            new Random(1).NextBytes(programa);
+            ram.Escrever(0, programa);
+
+            estado = new CpuState();
+            var metricas = new Metrics();
+            executor = new InstructionExecutor(ram, estado, metricas);
+            pic = new PicController();
+            cpu = new CpuSimulator(ram, pic, metricas, estado);
+            limitePc = ram.TamanhoEmBytes - 4 * (Instrucoes + 1);
+        }
+
+        [Benchmark(OperationsPerInvoke = Instrucoes)]
+        public void ExecuteNextInstruction()
+        {
+            if (estado.ContadorPrograma > limitePc) estado.ContadorPrograma = 0;
+            for (int i = 0; i < Instrucoes; i++) executor.ExecuteNextInstruction();
+        }
+
+        [Benchmark(OperationsPerInvoke = Instrucoes)]
+        public void Tick()
+        {
+            if (estado.ContadorPrograma > limitePc) estado.ContadorPrograma = 0;
+            for (int i = 0; i < Instrucoes; i++) cpu.Tick();
+        }
+    }
+}
@@ -0,0 +1,38 @@
+using BenchmarkDotNet.Attributes;
+using ProjetoSimuladorPC.DMA;
+using ProjetoSimuladorPC.RAM;
+using ControladorDma = ProjetoSimuladorPC.DMA.DMA;
+
+namespace ProjetoSimuladorPC.Benchmarks
+{
+    /// <summary>
+    /// Transferências DMA RAM→RAM e RAM→MMIO sem atraso simulado (delayMs = 0), medindo o custo
+    /// por byte do laço de cópia e do relatório de progresso.
+    /// </summary>
+    [Config(typeof(ConfiguracaoBenchmarks))]
+    public class DmaBenchmarks
+    {
+        const int Mmio = 0xF0000;
+
+        [Params(64, 4096)]
+        public int Tamanho { get; set; }
+
+        ControladorDma dma = null!;
+
+        [GlobalSetup]
+        public void Preparar()
+        {
+            var ram = new RamState(1);
+            var dados = new byte[Tamanho];
+            new Random(3).NextBytes(dados);
+            ram.Escrever(0, dados);
+            dma = new ControladorDma(ram, new DispositivoMMIO(Mmio, Mmio + 0xFF), new DmaState());
+        }
+
+        [Benchmark]
+        public Task RamParaRam() => dma.ExecutarTransferenciaAsync(0, 0x8000, Tamanho, 0);
+
+        [Benchmark]
+        public Task RamParaMmio() => dma.ExecutarTransferenciaAsync(0, Mmio, Tamanho, 0);
+    }
+}
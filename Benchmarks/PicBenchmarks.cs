@@ -0,0 +1,56 @@
+using BenchmarkDotNet.Attributes;
+using ProjetoSimIO.Core;
+
+namespace ProjetoSimuladorPC.Benchmarks
+{
+    /// <summary>
+    /// Ciclo raise → vetor pendente → ack do PicController, com e sem medição de latência.
+    /// </summary>
+    [Config(typeof(ConfiguracaoBenchmarks))]
+    public class PicBenchmarks
+    {
+        const int Ciclos = 1024;
+
+        [Params(false, true)]
+        public bool MedirLatencia { get; set; }
+
+        PicController pic = null!;
+        long relogio;
+
+        [GlobalSetup]
+        public void Preparar()
+        {
+            pic = new PicController();
+            if (MedirLatencia)
+            {
+                pic.Relogio = () => relogio;
+                pic.IrqReconhecida = (_, _) => { };
+            }
+        }
+
+        [Benchmark(OperationsPerInvoke = Ciclos)]
+        public void RaiseAck()
+        {
+            for (int i = 0; i < Ciclos; i++)
+            {
+                relogio++;
+                pic.RaiseIrq(i & 7);
+                if (pic.HasPendingIrq()) pic.AckIrq(pic.GetPendingVector());
+            }
+        }
+
+        /// <summary>
+        /// Oito linhas levantadas antes dos ACKs (fila cheia, ACK sempre no topo).
+        /// </summary>
+        [Benchmark(OperationsPerInvoke = Ciclos)]
+        public void RajadaOitoLinhas()
+        {
+            for (int i = 0; i < Ciclos; i += 8)
+            {
+                relogio++;
+                for (int linha = 0; linha < 8; linha++) pic.RaiseIrq(linha);
+                for (int v; (v = pic.GetPendingVector()) >= 0;) pic.AckIrq(v);
+            }
+        }
+    }
+}
@@ -0,0 +1,46 @@
+using System.Globalization;
+using BenchmarkDotNet.Running;
+using ProjetoSimuladorPC.Benchmarks;
+
+// Suíte de benchmarks dos caminhos quentes do simulador.
+//
+//   dotnet run -c Release --project Benchmarks -- --filter '*'            executa (argumentos do BenchmarkDotNet)
+//   dotnet run -c Release --project Benchmarks -- --filter '*Cache*' --comparar
+//                                                                          executa e compara com Baselines/
+//   dotnet run -c Release --project Benchmarks -- --salvar-baseline        promove os últimos resultados a baseline
+//   dotnet run -c Release --project Benchmarks -- --comparar [--tolerancia 0.10]
+//                                                                          só compara os últimos resultados
+//
+// Os resultados ficam em BenchmarkDotNet.Artifacts/results (JSON completo + markdown).
+
+const string Resultados = "BenchmarkDotNet.Artifacts/results";
+string baselines = Path.Combine(AppContext.BaseDirectory, "..", "..", "..", "Baselines");
+
+bool comparar = false, salvar = false;
+double tolerancia = 0.10;
+var argumentosBdn = new List<string>();
+
+for (int i = 0; i < args.Length; i++)
+{
+    switch (args[i])
+    {
+        case "--comparar": comparar = true; break;
+        case "--salvar-baseline": salvar = true; break;
+        case "--baselines" when i + 1 < args.Length: baselines = args[++i]; break;
+        case "--tolerancia" when i + 1 < args.Length:
+            tolerancia = double.Parse(args[++i], CultureInfo.InvariantCulture);
+            break;
+        default: argumentosBdn.Add(args[i]); break;
+    }
+}
+
+if (argumentosBdn.Count > 0)
+    BenchmarkSwitcher.FromAssembly(typeof(ConfiguracaoBenchmarks).Assembly).Run(argumentosBdn.ToArray());
+
+int codigo = 0;
+if (salvar) codigo = ComparadorBaseline.SalvarBaseline(Resultados, baselines);
+if (comparar && codigo == 0) codigo = ComparadorBaseline.Comparar(baselines, Resultados, tolerancia);
+if (argumentosBdn.Count == 0 && !salvar && !comparar)
+    BenchmarkSwitcher.FromAssembly(typeof(ConfiguracaoBenchmarks).Assembly).Run(args);
+
+return codigo;
@@ -0,0 +1,65 @@
+using BenchmarkDotNet.Attributes;
+using ProjetoSimuladorPC.Cache;
+using ProjetoSimuladorPC.RAM;
+
+namespace ProjetoSimuladorPC.Benchmarks
+{
+    /// <summary>
+    /// RamState.Ler/Escrever (byte e bloco), com e sem cache anexada.
+    /// </summary>
+    [Config(typeof(ConfiguracaoBenchmarks))]
+    public class RamBenchmarks
+    {
+        const int Operacoes = 1024;
+
+        [Params(false, true)]
+        public bool ComCache { get; set; }
+
+        [Params(4, 256)]
+        public int Bloco { get; set; }
+
+        RamState ram = null!;
+        byte[] dados = null!;
+        int limite;
+
+        [GlobalSetup]
+        public void Preparar()
+        {
+            ram = new RamState(1);
+            if (ComCache)
+                ram.AttachCache(new Cache.Cache(16 * 1024, 64, 2, ReplacementPolicy.LRU, WritePolicy.WriteThrough) { SincronizarFachada = false });
+
+            dados = new byte[Bloco];
+            new Random(7).NextBytes(dados);
+            limite = ram.TamanhoEmBytes - Bloco;
+        }
+
+        [Benchmark(OperationsPerInvoke = Operacoes)]
+        public int LerByte()
+        {
+            int soma = 0;
+            for (int i = 0; i < Operacoes; i++) soma += ram.Ler((i * 97) & 0xFFFF);
+            return soma;
+        }
+
+        [Benchmark(OperationsPerInvoke = Operacoes)]
+        public void EscreverByte()
+        {
+            for (int i = 0; i < Operacoes; i++) ram.Escrever((i * 97) & 0xFFFF, (byte)i);
+        }
+
+        [Benchmark(OperationsPerInvoke = Operacoes)]
+        public int LerBloco()
+        {
+            int soma = 0;
+            for (int i = 0; i < Operacoes; i++) soma += ram.Ler((i * Bloco) % limite, Bloco)[0];
+            return soma;
+        }
+
+        [Benchmark(OperationsPerInvoke = Operacoes)]
+        public void EscreverBloco()
+        {
+            for (int i = 0; i < Operacoes; i++) ram.Escrever((i * Bloco) % limite, dados);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+using BenchmarkDotNet.Attributes;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Benchmarks
+{
+    /// <summary>
+    /// SimulationState.GetSnapshot com diferentes tamanhos de preview da RAM, sobre a máquina
+    /// padrão montada pelo motor (cache e DMA reais): com o estado parado (partes reaproveitadas)
+    /// e com o motor avançando um ciclo entre snapshots (custo do ciclo incluído).
+    /// </summary>
+    [Config(typeof(ConfiguracaoBenchmarks))]
+    public class SnapshotBenchmarks
+    {
+        [Params(0, 16, 4096)]
+        public int Preview { get; set; }
+
+        SimulationState state = null!;
+        SimulationEngine engine = null!;
+
+        [GlobalSetup]
+        public void Preparar()
+        {
+            state = new SimulationState();
+            engine = new SimulationEngine(state);
+            engine.RunCycles(10_000);
+        }
+
+        [GlobalCleanup]
+        public void Encerrar() => engine.Dispose();
+
+        [Benchmark]
+        public SimulationSnapshot GetSnapshot() => state.GetSnapshot(0x100, Preview);
+
+        [Benchmark]
+        public SimulationSnapshot GetSnapshotComMudanca()
+        {
+            engine.AdvanceOneCycle();
+            return state.GetSnapshot(0x100, Preview);
+        }
+    }
+}
@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Generic;
 
 namespace ProjetoSimuladorPC.Cache
 {
@@ -53,6 +54,11 @@ namespace ProjetoSimuladorPC.Cache
 
         readonly CacheSet[] sets;
 
+        // decomposio do endereo, calculada uma vez no construtor
+        readonly int offsetBits;
+        readonly uint setMask;
+        readonly int tagShift;
+
         // Fachada de estado opcional (preenchida pela simulao)
         readonly CacheState? _state;
 
@@ -64,6 +70,12 @@ namespace ProjetoSimuladorPC.Cache
         public ulong Misses { get; private set; }
         public ulong MemoryWrites { get; private set; } // conta escritas para memria principal
 
+        /// <summary>
+        /// Quando false, os acessos no atualizam a fachada (evita um lock por acesso em
+        /// execues em lote); chame <see cref="UpdateState"/> ao final para sincronizar.
+        /// </summary>
+        public bool SincronizarFachada { get; set; } = true;
+
         /// <summary>
         /// Cria uma nova instncia da cache. Se fornecer <paramref name="state"/>, a cache ir preench-la
         /// com metadados e contadores; caso contrrio comportamento fica apenas interno.
@@ -85,6 +97,13 @@ namespace ProjetoSimuladorPC.Cache
             sets = new CacheSet[numSets];
             for (int i = 0; i < numSets; i++) sets[i] = new CacheSet(associativity);
 
+            offsetBits = (int)Math.Log(blockSizeBytes, 2);
+            int setBits = (int)Math.Log(numSets, 2);
+            if (Math.Pow(2, offsetBits) != blockSizeBytes) offsetBits = CountBitsNeeded(blockSizeBytes); // fallback
+            if (Math.Pow(2, setBits) != numSets) setBits = CountBitsNeeded(numSets);
+            setMask = numSets > 1 ? (uint)((1 << setBits) - 1) : 0;
+            tagShift = offsetBits + (numSets > 1 ? (int)Math.Log(numSets, 2) : 0);
+
             Reads = Writes = Hits = Misses = MemoryWrites = 0;
 
             _state = state;
@@ -100,20 +119,9 @@ namespace ProjetoSimuladorPC.Cache
         // Decodifica endereo (32 bits) em tag, ndice do conjunto e offset
         void DecodeAddress(uint address, out ulong tag, out int setIndex, out int offset)
         {
-            int offsetBits = (int)Math.Log(blockSizeBytes, 2);
-            int setBits = (int)Math.Log(numSets, 2);
-            if (Math.Pow(2, offsetBits) != blockSizeBytes) offsetBits = CountBitsNeeded(blockSizeBytes); // fallback
-            if (Math.Pow(2, setBits) != numSets) setBits = CountBitsNeeded(numSets);
-
             offset = (int)(address & ((uint)(blockSizeBytes - 1)));
-            if (numSets > 1)
-            {
-                uint setMask = (uint)((1 << setBits) - 1);
-                setIndex = (int)((address >> offsetBits) & setMask);
-            }
-            else setIndex = 0;
-
-            tag = (ulong)(address >> (offsetBits + (numSets > 1 ? (int)Math.Log(numSets, 2) : 0)));
+            setIndex = (int)((address >> offsetBits) & setMask);
+            tag = (ulong)(address >> tagShift);
         }
 
         int CountBitsNeeded(int v)
@@ -246,10 +254,156 @@ namespace ProjetoSimuladorPC.Cache
 
         void UpdateStateCounters()
         {
-            if (_state == null) return;
+            if (_state == null || !SincronizarFachada) return;
             _state.UpdateCounters(Reads, Writes, Hits, Misses, MemoryWrites);
         }
 
+        /// <summary>
+        /// Exporta as linhas vlidas como endereos de bloco, da menos para a mais recentemente usada
+        /// (usado para migrar o contedo ao reconstruir a cache com outra geometria).
+        /// </summary>
+        public List<(uint enderecoBloco, bool dirty)> ExportarLinhas()
+        {
+            var linhas = new List<(uint, bool, ulong)>();
+            for (int s = 0; s < numSets; s++)
+            {
+                foreach (var l in sets[s].Lines)
+                {
+                    if (l.Valid) linhas.Add((EnderecoDoBloco(l.Tag, s), l.Dirty, l.LastUsedCounter));
+                }
+            }
+            linhas.Sort((a, b) => a.Item3.CompareTo(b.Item3));
+            return linhas.ConvertAll(l => (l.Item1, l.Item2));
+        }
+
+        /// <summary>
+        /// Insere um bloco sem contabilizar como acesso (migrao). Vtimas sujas em write-back
+        /// e blocos sujos importados numa cache write-through contam como escrita na memria.
+        /// </summary>
+        public void ImportarLinha(uint enderecoBloco, bool dirty)
+        {
+            DecodeAddress(enderecoBloco, out ulong tag, out int setIndex, out _);
+            var set = sets[setIndex];
+
+            for (int i = 0; i < set.Associativity; i++)
+            {
+                var line = set.Lines[i];
+                if (line.Valid && line.Tag == tag)
+                {
+                    line.LastUsedCounter = globalCounter++;
+                    MarcarImportada(line, dirty);
+                    return;
+                }
+            }
+
+            CacheBlock? destino = null;
+            for (int i = 0; i < set.Associativity && destino is null; i++)
+            {
+                if (!set.Lines[i].Valid) destino = set.Lines[i];
+            }
+            if (destino is null)
+            {
+                destino = set.Lines[SelectVictimLine(set)];
+                if (destino.Dirty && writePolicy == WritePolicy.WriteBack) MemoryWrites++;
+            }
+
+            destino.Valid = true;
+            destino.Tag = tag;
+            destino.Dirty = false;
+            destino.LastUsedCounter = globalCounter++;
+            destino.InsertCounter = globalCounter;
+            MarcarImportada(destino, dirty);
+        }
+
+        void MarcarImportada(CacheBlock line, bool dirty)
+        {
+            if (!dirty) return;
+            if (writePolicy == WritePolicy.WriteBack) line.Dirty = true;
+            else MemoryWrites++; // write-through: o bloco sujo  descarregado na migrao
+        }
+
+        /// <summary>
+        /// Restaura contadores acumulados (ex.: de uma cache substituda) e sincroniza a fachada.
+        /// </summary>
+        public void RestaurarContadores(ulong reads, ulong writes, ulong hits, ulong misses, ulong memoryWrites)
+        {
+            Reads = reads;
+            Writes = writes;
+            Hits = hits;
+            Misses = misses;
+            MemoryWrites += memoryWrites;
+            UpdateState();
+        }
+
+        /// <summary>
+        /// Grava geometria, contadores e todas as linhas (inclusive os carimbos LRU/FIFO) num checkpoint.
+        /// </summary>
+        public void SalvarEstado(BinaryWriter w)
+        {
+            w.Write(cacheSizeBytes);
+            w.Write(blockSizeBytes);
+            w.Write(associativity);
+            w.Write((byte)replPolicy);
+            w.Write((byte)writePolicy);
+            w.Write(globalCounter);
+            w.Write(Reads);
+            w.Write(Writes);
+            w.Write(Hits);
+            w.Write(Misses);
+            w.Write(MemoryWrites);
+
+            for (int s = 0; s < numSets; s++)
+            {
+                foreach (var l in sets[s].Lines)
+                {
+                    w.Write(l.Valid);
+                    w.Write(l.Tag);
+                    w.Write(l.Dirty);
+                    w.Write(l.LastUsedCounter);
+                    w.Write(l.InsertCounter);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Restaura o estado gravado por <see cref="SalvarEstado"/> e sincroniza a fachada.
+        /// A geometria e as polticas devem ser iguais s desta instncia.
+        /// </summary>
+        public void RestaurarEstado(BinaryReader r)
+        {
+            int tamanho = r.ReadInt32(), bloco = r.ReadInt32(), assoc = r.ReadInt32();
+            var repl = (ReplacementPolicy)r.ReadByte();
+            var escrita = (WritePolicy)r.ReadByte();
+            if (tamanho != cacheSizeBytes || bloco != blockSizeBytes || assoc != associativity || repl != replPolicy || escrita != writePolicy)
+                throw new InvalidDataException("A geometria da cache no checkpoint difere da cache atual.");
+
+            globalCounter = r.ReadUInt64();
+            Reads = r.ReadUInt64();
+            Writes = r.ReadUInt64();
+            Hits = r.ReadUInt64();
+            Misses = r.ReadUInt64();
+            MemoryWrites = r.ReadUInt64();
+
+            for (int s = 0; s < numSets; s++)
+            {
+                foreach (var l in sets[s].Lines)
+                {
+                    l.Valid = r.ReadBoolean();
+                    l.Tag = r.ReadUInt64();
+                    l.Dirty = r.ReadBoolean();
+                    l.LastUsedCounter = r.ReadUInt64();
+                    l.InsertCounter = r.ReadUInt64();
+                }
+            }
+            UpdateState();
+        }
+
+        // Inverso de DecodeAddress (offset zero)
+        uint EnderecoDoBloco(ulong tag, int setIndex)
+        {
+            return (uint)((tag << tagShift) | ((ulong)setIndex << offsetBits));
+        }
+
         /// <summary>
         /// Retorna uma cpia simples do layout atual da cache (para UI/inspeo).
         /// Cada conjunto contm um array de tuplas (valid, tag, dirty).
@@ -10,12 +10,16 @@ namespace ProjetoSimuladorPC.Cache
     {
         private readonly object _sync = new();
 
+        // sequência de escrita dos contadores (ímpar = atualização em andamento)
+        private long _seq;
+        private ulong _reads, _writes, _hits, _misses, _memoryWrites;
+
         // Contadores observáveis
-        public ulong Reads { get; private set; }
-        public ulong Writes { get; private set; }
-        public ulong Hits { get; private set; }
-        public ulong Misses { get; private set; }
-        public ulong MemoryWrites { get; private set; }
+        public ulong Reads => _reads;
+        public ulong Writes => _writes;
+        public ulong Hits => _hits;
+        public ulong Misses => _misses;
+        public ulong MemoryWrites => _memoryWrites;
 
         // Metadados da configuração da cache
         public int CacheSizeBytes { get; private set; }
@@ -26,28 +30,40 @@ namespace ProjetoSimuladorPC.Cache
         public string WritePolicy { get; private set; } = string.Empty;
 
         // Info derivada
-        public double HitRate
+        public double HitRate => LerContadores().HitRate;
+
+        public double MissRate => LerContadores().MissRate;
+
+        /// <summary>
+        /// Leitura consistente (todos da mesma atualização) dos contadores, sem lock: repete se
+        /// uma atualização concorrente estiver em andamento.
+        /// </summary>
+        public ContadoresCache LerContadores()
         {
-            get
+            var espera = new SpinWait();
+            while (true)
             {
-                lock (_sync)
+                long seq = Volatile.Read(ref _seq);
+                if ((seq & 1) == 0)
                 {
-                    var total = (double)(Reads + Writes);
-                    return total > 0 ? (double)Hits / total : 0.0;
+                    var c = new ContadoresCache(_reads, _writes, _hits, _misses, _memoryWrites);
+                    Interlocked.MemoryBarrier();
+                    if (Volatile.Read(ref _seq) == seq) return c;
                 }
+                espera.SpinOnce();
             }
         }
 
-        public double MissRate
+        // chamado sob _sync (um escritor por vez)
+        private void GravarContadores(ulong reads, ulong writes, ulong hits, ulong misses, ulong memoryWrites)
         {
-            get
-            {
-                lock (_sync)
-                {
-                    var total = (double)(Reads + Writes);
-                    return total > 0 ? (double)Misses / total : 0.0;
-                }
-            }
+            Interlocked.Increment(ref _seq);
+            _reads = reads;
+            _writes = writes;
+            _hits = hits;
+            _misses = misses;
+            _memoryWrites = memoryWrites;
+            Interlocked.Increment(ref _seq);
         }
 
         public DateTime LastUpdated { get; private set; } = DateTime.MinValue;
@@ -71,11 +87,7 @@ namespace ProjetoSimuladorPC.Cache
         {
             lock (_sync)
             {
-                Reads = reads;
-                Writes = writes;
-                Hits = hits;
-                Misses = misses;
-                MemoryWrites = memoryWrites;
+                GravarContadores(reads, writes, hits, misses, memoryWrites);
 
                 CacheSizeBytes = cacheSizeBytes;
                 BlockSizeBytes = blockSizeBytes;
@@ -95,13 +107,18 @@ namespace ProjetoSimuladorPC.Cache
         {
             lock (_sync)
             {
-                Reads = reads;
-                Writes = writes;
-                Hits = hits;
-                Misses = misses;
-                MemoryWrites = memoryWrites;
+                GravarContadores(reads, writes, hits, misses, memoryWrites);
                 LastUpdated = DateTime.UtcNow;
             }
         }
     }
+
+    /// <summary>
+    /// Contadores da cache lidos de uma única atualização (ver <see cref="CacheState.LerContadores"/>).
+    /// </summary>
+    public readonly record struct ContadoresCache(ulong Reads, ulong Writes, ulong Hits, ulong Misses, ulong MemoryWrites)
+    {
+        public double HitRate => Reads + Writes > 0 ? (double)Hits / (Reads + Writes) : 0.0;
+        public double MissRate => Reads + Writes > 0 ? (double)Misses / (Reads + Writes) : 0.0;
+    }
 }
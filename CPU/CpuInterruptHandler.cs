@@ -24,6 +24,15 @@ namespace ProjetoSimuladorPC.Cpu
             _metricas = metricas;
         }
 
+        /// <summary>
+        /// Profundidade atual de ISRs aninhadas (salva/restaurada em checkpoints).
+        /// </summary>
+        public int NivelAninhamento
+        {
+            get => _nivelNesting;
+            set => _nivelNesting = Math.Max(0, value);
+        }
+
         public void HandleInterrupt(int vetor)
         {
             // Marca entrada no ISR
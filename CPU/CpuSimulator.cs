@@ -46,7 +46,21 @@ namespace ProjetoSimuladorPC.Cpu
             try { metricas.MemoryWrites++; } catch { }
         }
 
+        /// <summary>
+        /// Ciclos contabilizados por esta CPU (executados + ociosos).
+        /// </summary>
+        public long Ciclos => (long)contadorCiclos;
+
         public void StepInstruction() => executor.ExecuteNextInstruction();
+
+        /// <summary>
+        /// Observador das instrues executadas (trace); null desliga.
+        /// </summary>
+        public IObservadorExecucao? Observador
+        {
+            get => executor.Observador;
+            set => executor.Observador = value;
+        }
         public bool IrqPending() => controladorPic.HasPendingIrq();
         public void AckIrq(int vector) => controladorPic.AckIrq(vector);
 
@@ -72,6 +86,59 @@ namespace ProjetoSimuladorPC.Cpu
             catch { }
         }
 
+        /// <summary>
+        /// Verdadeiro quando a CPU est parada e nenhuma IRQ atendvel est pendente:
+        /// nenhum Tick mudaria o estado, ento o motor pode saltar direto ao prximo evento.
+        /// </summary>
+        public bool EstaOciosa => estado.Parado && !(estado.InterrupcaoHabilitada && IrqPending());
+
+        /// <summary>
+        /// Contabiliza <paramref name="ciclos"/> ciclos ociosos sem execut-los um a um.
+        /// </summary>
+        public void AvancarOcioso(long ciclos)
+        {
+            if (ciclos <= 0) return;
+            contadorCiclos += (ulong)ciclos;
+            try { metricas.TotalCycles = (long)contadorCiclos; }
+            catch { }
+        }
+
+        /// <summary>
+        /// Grava registradores, contador de ciclos e aninhamento de ISR num checkpoint.
+        /// </summary>
+        public void SalvarEstado(BinaryWriter w)
+        {
+            w.Write(estado.ContadorPrograma);
+            w.Write(estado.Acumulador);
+            w.Write(estado.InterrupcaoHabilitada);
+            w.Write(estado.Parado);
+            w.Write(estado.UltimoEnderecoAcesso);
+            w.Write(estado.UltimoDadoLido);
+            w.Write(estado.UltimoDadoEscrito);
+            w.Write(estado.OperacaoAtual ?? string.Empty);
+            w.Write(contadorCiclos);
+            w.Write(tratadorIrq.NivelAninhamento);
+        }
+
+        /// <summary>
+        /// Restaura o estado gravado por <see cref="SalvarEstado"/> na CpuState compartilhada.
+        /// </summary>
+        public void RestaurarEstado(BinaryReader r)
+        {
+            estado.ContadorPrograma = r.ReadInt32();
+            estado.Acumulador = r.ReadUInt32();
+            estado.InterrupcaoHabilitada = r.ReadBoolean();
+            estado.Parado = r.ReadBoolean();
+            estado.UltimoEnderecoAcesso = r.ReadInt32();
+            estado.UltimoDadoLido = r.ReadUInt32();
+            estado.UltimoDadoEscrito = r.ReadUInt32();
+            estado.OperacaoAtual = r.ReadString();
+            contadorCiclos = r.ReadUInt64();
+            tratadorIrq.NivelAninhamento = r.ReadInt32();
+            try { metricas.TotalCycles = (long)contadorCiclos; }
+            catch { }
+        }
+
         // Exponha retorno do ISR se outro cdigo precisar invoc-lo
         public void ReturnFromInterrupt() => tratadorIrq.ReturnFromInterrupt();
     }
@@ -1,4 +1,5 @@
 using ProjetoSimuladorPC.RAM;
+using ProjetoSimuladorPC.Utilidades;
 
 namespace ProjetoSimuladorPC.Cpu
 {
@@ -19,12 +20,25 @@ namespace ProjetoSimuladorPC.Cpu
             this.metricas = metricas;
         }
 
+        /// <summary>
+        /// Observador notificado de cada instruo buscada (PC e palavra lida), para traces.
+        /// </summary>
+        public IObservadorExecucao? Observador { get; set; }
+
         public void ExecuteNextInstruction()
         {
             // Exemplo: carregar 4 bytes do endereo do PC e armazenar em um MMIO exemplo.
             estado.OperacaoAtual = "LOAD";
             int endereco = estado.ContadorPrograma;
 
+            // checagem de limites antecipada: evita o custo de uma exceo por ciclo
+            // quando o PC sai da RAM (a CPU permanece em FAULT a cada tick)
+            if (endereco < 0 || endereco > ram.TamanhoEmBytes - 4)
+            {
+                estado.OperacaoAtual = "FAULT";
+                return;
+            }
+
             byte[] dadosLidos;
             try
             {
@@ -38,6 +52,7 @@ namespace ProjetoSimuladorPC.Cpu
             }
 
             uint valor = BitConverter.ToUInt32(dadosLidos, 0);
+            Observador?.Instrucao(endereco, valor);
             estado.UltimoEnderecoAcesso = endereco;
             estado.UltimoDadoLido = valor;
             estado.Acumulador = valor;
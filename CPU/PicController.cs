@@ -1,4 +1,6 @@
 
+using ProjetoSimuladorPC.Utilidades;
+
 namespace ProjetoSimIO.Core
 {
     /// <summary>
@@ -11,6 +13,20 @@ namespace ProjetoSimIO.Core
         private readonly HashSet<int> pendentes = new();
         private readonly HashSet<int> mascaradas = new();
 
+        // momento (no relgio abaixo) em que cada linha pendente foi levantada
+        private readonly Dictionary<int, long> momentoRaise = new();
+
+        /// <summary>
+        /// Relgio em ciclos usado para medir a latncia das IRQs (opcional).
+        /// </summary>
+        public Func<long>? Relogio { get; set; }
+
+        /// <summary>
+        /// Chamado no ACK com o vetor e a latncia (ciclos entre RaiseIrq e AckIrq).
+        /// S dispara se <see cref="Relogio"/> estiver definido.
+        /// </summary>
+        public Action<int, long>? IrqReconhecida { get; set; }
+
         public bool HasPendingIrq()
         {
             lock (fila)
@@ -37,6 +53,7 @@ namespace ProjetoSimIO.Core
                 {
                     fila.Dequeue();
                     pendentes.Remove(vector);
+                    RegistrarLatencia(vector);
                 }
                 else
                 {
@@ -48,6 +65,7 @@ namespace ProjetoSimIO.Core
                         fila.Clear();
                         foreach (var v in items) fila.Enqueue(v);
                         pendentes.Remove(vector);
+                        RegistrarLatencia(vector);
                     }
                 }
             }
@@ -61,6 +79,66 @@ namespace ProjetoSimIO.Core
                 if (pendentes.Contains(irqLine)) return;
                 fila.Enqueue(irqLine);
                 pendentes.Add(irqLine);
+                SimuladorEventSource.Log.IrqLevantada();
+                if (Relogio is { } relogio) momentoRaise[irqLine] = relogio();
+            }
+        }
+
+        // chamado sob o lock da fila
+        private void RegistrarLatencia(int vector)
+        {
+            SimuladorEventSource.Log.IrqReconhecida();
+            if (!momentoRaise.Remove(vector, out var inicio) || Relogio is not { } relogio) return;
+            IrqReconhecida?.Invoke(vector, relogio() - inicio);
+        }
+
+        /// <summary>
+        /// Grava fila de pendentes (em ordem), mscaras e momentos de raise num checkpoint.
+        /// </summary>
+        public void SalvarEstado(BinaryWriter w)
+        {
+            lock (fila)
+            {
+                w.Write(fila.Count);
+                foreach (var v in fila) w.Write(v);
+                w.Write(mascaradas.Count);
+                foreach (var m in mascaradas) w.Write(m);
+                w.Write(momentoRaise.Count);
+                foreach (var (linha, momento) in momentoRaise)
+                {
+                    w.Write(linha);
+                    w.Write(momento);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Substitui o estado atual pelo gravado em <see cref="SalvarEstado"/>.
+        /// </summary>
+        public void RestaurarEstado(BinaryReader r)
+        {
+            lock (fila)
+            {
+                fila.Clear();
+                pendentes.Clear();
+                mascaradas.Clear();
+                momentoRaise.Clear();
+
+                int n = r.ReadInt32();
+                for (int i = 0; i < n; i++)
+                {
+                    int v = r.ReadInt32();
+                    fila.Enqueue(v);
+                    pendentes.Add(v);
+                }
+                n = r.ReadInt32();
+                for (int i = 0; i < n; i++) mascaradas.Add(r.ReadInt32());
+                n = r.ReadInt32();
+                for (int i = 0; i < n; i++)
+                {
+                    int linha = r.ReadInt32();
+                    momentoRaise[linha] = r.ReadInt64();
+                }
             }
         }
 
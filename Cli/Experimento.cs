@@ -0,0 +1,69 @@
+using System.Text.Json.Serialization;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Cli
+{
+    /// <summary>
+    /// Arquivo de experimento do simulador headless: mesmos campos do corpo de POST api/sweep
+    /// (configuração base + eixos da grade e/ou variantes explícitas), mais a carga de trabalho
+    /// e o destino dos resultados. Caminhos relativos partem da pasta do arquivo.
+    /// </summary>
+    public sealed class Experimento
+    {
+        public string? Nome { get; set; }
+        public long Ciclos { get; set; } = 1_000_000;
+        public int? Paralelismo { get; set; }
+
+        public Configuracoes? Base { get; set; }
+        public List<string>? L1Sizes { get; set; }
+        public List<int>? L1Assocs { get; set; }
+        public List<int>? L1LineSizes { get; set; }
+        public List<string>? L1WritePolicies { get; set; }
+        public List<int>? TimerPeriods { get; set; }
+
+        public List<Configuracoes>? Variacoes { get; set; }
+
+        /// <summary>Imagem binária carregada na RAM em <see cref="EnderecoCarga"/> antes de cada variante.</summary>
+        public string? Imagem { get; set; }
+        public int EnderecoCarga { get; set; }
+
+        /// <summary>"csv" (padrão) ou "json".</summary>
+        public string? Formato { get; set; }
+
+        /// <summary>Arquivo de resultados; ausente = saída padrão.</summary>
+        public string? Saida { get; set; }
+
+        internal bool TemEixos =>
+            L1Sizes is { Count: > 0 } || L1Assocs is { Count: > 0 } || L1LineSizes is { Count: > 0 }
+            || L1WritePolicies is { Count: > 0 } || TimerPeriods is { Count: > 0 };
+
+        /// <summary>
+        /// Variantes do experimento, na mesma ordem de api/sweep: explícitas e depois a grade.
+        /// </summary>
+        public IReadOnlyList<VariacaoSweep> Variantes()
+        {
+            var variacoes = new List<VariacaoSweep>();
+            if (Variacoes is { Count: > 0 })
+            {
+                for (int i = 0; i < Variacoes.Count; i++)
+                    variacoes.Add(new VariacaoSweep($"v{i}", Variacoes[i]));
+            }
+            if (Variacoes is not { Count: > 0 } || TemEixos)
+                variacoes.AddRange(SweepRunner.Grade(Base ?? new Configuracoes(), L1Sizes, L1Assocs, L1LineSizes, L1WritePolicies, TimerPeriods));
+            return variacoes;
+        }
+    }
+
+    // serialização gerada em tempo de compilação (sem reflexão: compatível com Native AOT/trimming)
+    [JsonSourceGenerationOptions(
+        PropertyNamingPolicy = JsonKnownNamingPolicy.CamelCase,
+        PropertyNameCaseInsensitive = true,
+        ReadCommentHandling = System.Text.Json.JsonCommentHandling.Skip,
+        AllowTrailingCommas = true,
+        WriteIndented = true)]
+    [JsonSerializable(typeof(Experimento))]
+    [JsonSerializable(typeof(IReadOnlyList<ResultadoSweep>))]
+    internal partial class ContextoJson : JsonSerializerContext
+    {
+    }
+}
@@ -0,0 +1,140 @@
+using System.Diagnostics;
+using System.Text.Json;
+using ProjetoSimuladorPC.Cli;
+using ProjetoSimuladorPC.Utilidades;
+
+// Simulador headless: roda as variantes de um experimento (ver Experimento) em máquinas
+// isoladas, em paralelo, e escreve a tabela de resultados.
+//
+//   ProjetoSimuladorPC.Cli experimento.json                       resultados em CSV na saída padrão
+//   ProjetoSimuladorPC.Cli experimento.json --formato json --saida resultados.json
+//   ProjetoSimuladorPC.Cli - < experimento.json                   experimento lido da entrada padrão
+//   ProjetoSimuladorPC.Cli --ciclos 1000000                       uma variante com a configuração padrão
+//
+// Código de saída: 0 = ok, 1 = alguma variante falhou ou foi cancelada, 2 = uso/arquivo inválido.
+
+var inicioProcesso = Process.GetCurrentProcess().StartTime.ToUniversalTime();
+
+string? arquivo = null, formato = null, saida = null;
+long? ciclos = null;
+int? paralelismo = null;
+
+for (int i = 0; i < args.Length; i++)
+{
+    switch (args[i])
+    {
+        case "--formato" when i + 1 < args.Length: formato = args[++i]; break;
+        case "--saida" when i + 1 < args.Length: saida = args[++i]; break;
+        case "--ciclos" when i + 1 < args.Length && long.TryParse(args[i + 1], out var c): ciclos = c; i++; break;
+        case "--paralelismo" when i + 1 < args.Length && int.TryParse(args[i + 1], out var p): paralelismo = p; i++; break;
+        case "-h" or "--ajuda": return Uso();
+        default:
+            if (arquivo is not null || (args[i].StartsWith("--", StringComparison.Ordinal))) return Uso();
+            arquivo = args[i];
+            break;
+    }
+}
+
+if (arquivo is null && ciclos is null) return Uso();
+
+Experimento experimento;
+string pastaBase = Directory.GetCurrentDirectory();
+try
+{
+    if (arquivo is null)
+    {
+        experimento = new Experimento();
+    }
+    else
+    {
+        using var entrada = arquivo == "-" ? Console.OpenStandardInput() : File.OpenRead(arquivo);
+        experimento = JsonSerializer.Deserialize(entrada, ContextoJson.Default.Experimento)
+            ?? throw new JsonException("Experimento vazio.");
+        if (arquivo != "-") pastaBase = Path.GetDirectoryName(Path.GetFullPath(arquivo))!;
+    }
+}
+catch (Exception ex) when (ex is IOException or UnauthorizedAccessException or JsonException)
+{
+    Console.Error.WriteLine($"Experimento inválido: {ex.Message}");
+    return 2;
+}
+
+// a linha de comando prevalece sobre o arquivo
+if (ciclos is not null) experimento.Ciclos = ciclos.Value;
+if (paralelismo is not null) experimento.Paralelismo = paralelismo;
+formato ??= experimento.Formato ?? "csv";
+saida ??= experimento.Saida is null ? null : Path.Combine(pastaBase, experimento.Saida);
+
+if (experimento.Ciclos <= 0)
+{
+    Console.Error.WriteLine("Ciclos deve ser positivo.");
+    return 2;
+}
+if (formato is not ("csv" or "json"))
+{
+    Console.Error.WriteLine($"Formato desconhecido: {formato} (use csv ou json).");
+    return 2;
+}
+
+byte[]? imagem = null;
+if (experimento.Imagem is not null)
+{
+    try
+    {
+        imagem = File.ReadAllBytes(Path.Combine(pastaBase, experimento.Imagem));
+    }
+    catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+    {
+        Console.Error.WriteLine($"Imagem inválida: {ex.Message}");
+        return 2;
+    }
+}
+
+using var cts = new CancellationTokenSource();
+Console.CancelKeyPress += (_, e) =>
+{
+    // primeiro Ctrl+C encerra as variantes em andamento e ainda escreve os resultados parciais
+    e.Cancel = true;
+    cts.Cancel();
+};
+
+IReadOnlyList<VariacaoSweep> variacoes;
+try
+{
+    variacoes = experimento.Variantes();
+}
+catch (ArgumentException ex)
+{
+    Console.Error.WriteLine($"Experimento inválido: {ex.Message}");
+    return 2;
+}
+var carga = new CargaTrabalho(experimento.Nome ?? "padrao", experimento.Ciclos, imagem, experimento.EnderecoCarga);
+double partidaMs = (DateTime.UtcNow - inicioProcesso).TotalMilliseconds;
+
+var relogio = Stopwatch.StartNew();
+var resultados = await SweepRunner.ExecutarAsync(variacoes, carga, experimento.Paralelismo, cts.Token);
+relogio.Stop();
+
+using (var destino = saida is null ? Console.OpenStandardOutput() : File.Create(saida))
+{
+    if (formato == "json")
+    {
+        JsonSerializer.Serialize(destino, resultados, ContextoJson.Default.IReadOnlyListResultadoSweep);
+    }
+    else
+    {
+        using var w = new StreamWriter(destino);
+        SweepRunner.EscreverCsv(w, resultados);
+    }
+}
+
+int falhas = resultados.Count(r => r.Erro is not null);
+Console.Error.WriteLine($"{resultados.Count} variante(s), {falhas} com erro; partida {partidaMs:F0} ms, execução {relogio.Elapsed.TotalMilliseconds:F0} ms.");
+return falhas == 0 ? 0 : 1;
+
+static int Uso()
+{
+    Console.Error.WriteLine("uso: ProjetoSimuladorPC.Cli <experimento.json | -> [--formato csv|json] [--saida arquivo] [--ciclos N] [--paralelismo N]");
+    Console.Error.WriteLine("     ProjetoSimuladorPC.Cli --ciclos N   (configuração padrão)");
+    return 2;
+}
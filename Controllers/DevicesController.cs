@@ -0,0 +1,62 @@
+using Microsoft.AspNetCore.Mvc;
+using ProjetoSimuladorPC.Dispositivos;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Controllers
+{
+    /// <summary>
+    /// Dispositivos simulados em paralelo com a CPU (ver <see cref="CoordenadorDispositivos"/>).
+    /// </summary>
+    [ApiController]
+    [Route("api/simulation/devices")]
+    public class DevicesController : ControllerBase
+    {
+        private readonly SimulationEngine _engine;
+
+        public DevicesController(SimulationEngine engine)
+        {
+            _engine = engine;
+        }
+
+        [HttpGet]
+        public ActionResult<IReadOnlyList<InfoDispositivo>> Listar() => Ok(_engine.ListarDispositivos());
+
+        /// <summary>
+        /// Registra um console serial. 409 com a depuração reversa ativa.
+        /// </summary>
+        [HttpPost("console")]
+        public ActionResult<InfoDispositivo> AdicionarConsole(
+            [FromQuery] string nome = "console",
+            [FromQuery] int ciclosPorByte = 1_000,
+            [FromQuery] int vetorIrq = 1,
+            [FromQuery] long latencia = 256)
+        {
+            try
+            {
+                var console = new DispositivoConsole(nome, ciclosPorByte, vetorIrq, latencia);
+                _engine.AdicionarDispositivo(console);
+                return Ok(_engine.ListarDispositivos()[console.Indice]);
+            }
+            catch (ArgumentException ex)
+            {
+                return BadRequest(ex.Message);
+            }
+            catch (InvalidOperationException ex)
+            {
+                return Conflict(ex.Message);
+            }
+        }
+
+        /// <summary>
+        /// Escreve num registrador do dispositivo <paramref name="indice"/> (efeito após a latência dele).
+        /// </summary>
+        [HttpPost("{indice:int}/registro/{registro:int}")]
+        public IActionResult EscreverRegistro(int indice, int registro, [FromQuery] long valor)
+        {
+            var dispositivo = _engine.ObterDispositivo(indice);
+            if (dispositivo is null) return NotFound();
+            _engine.EnviarAoDispositivo(dispositivo, registro, valor);
+            return Accepted();
+        }
+    }
+}
@@ -0,0 +1,103 @@
+using System.ComponentModel.DataAnnotations;
+using Microsoft.AspNetCore.Mvc;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Controllers
+{
+    /// <summary>
+    /// Jobs de simulação longos executados em segundo plano (ver <see cref="GerenciadorJobs"/>).
+    /// </summary>
+    [ApiController]
+    [Route("api/jobs")]
+    public class JobsController : ControllerBase
+    {
+        private readonly GerenciadorJobs _jobs;
+
+        // orçamento máximo de um job (~minutos a vazões típicas) e tamanho da imagem carregada
+        private const long MaxCiclos = 100_000_000_000;
+        private const int MaxRamMB = 64;
+
+        public JobsController(GerenciadorJobs jobs)
+        {
+            _jobs = jobs;
+        }
+
+        /// <summary>
+        /// Enfileira um job e responde 202 com a URL de consulta. 503 se a fila estiver cheia.
+        /// </summary>
+        [HttpPost]
+        public ActionResult<EstadoJob> Criar([FromBody] JobRequest request)
+        {
+            if (request.Ciclos <= 0 || request.Ciclos > MaxCiclos)
+                return BadRequest($"Ciclos deve estar entre 1 e {MaxCiclos}.");
+            int ramMB = request.RamMB ?? 1;
+            if (ramMB <= 0 || ramMB > MaxRamMB)
+                return BadRequest($"RamMB deve estar entre 1 e {MaxRamMB}.");
+
+            byte[]? imagem = null;
+            if (!string.IsNullOrEmpty(request.ImagemBase64))
+            {
+                try { imagem = Convert.FromBase64String(request.ImagemBase64); }
+                catch (FormatException) { return BadRequest("ImagemBase64 inválida."); }
+                if (request.EnderecoCarga < 0 || (long)request.EnderecoCarga + imagem.Length > ramMB * 1024L * 1024)
+                    return BadRequest("A imagem não cabe na RAM a partir de EnderecoCarga.");
+            }
+
+            try
+            {
+                var carga = new CargaTrabalho(request.Nome ?? "job", request.Ciclos, imagem, request.EnderecoCarga);
+                var job = _jobs.Enfileirar(request.Nome, request.Config ?? new Configuracoes(), carga, ramMB);
+                return AcceptedAtAction(nameof(Obter), new { id = job.Id }, job.ObterEstado());
+            }
+            catch (Exception ex) when (ex is ValidationException or ArgumentException)
+            {
+                return BadRequest(ex.Message);
+            }
+            catch (InvalidOperationException ex)
+            {
+                return StatusCode(StatusCodes.Status503ServiceUnavailable, ex.Message);
+            }
+        }
+
+        [HttpGet]
+        public ActionResult<IReadOnlyList<EstadoJob>> Listar() => Ok(_jobs.Listar());
+
+        /// <summary>
+        /// Progresso (último checkpoint) e, ao final, o resultado do job.
+        /// </summary>
+        [HttpGet("{id}")]
+        public ActionResult<EstadoJob> Obter(string id)
+        {
+            var job = _jobs.Obter(id);
+            return job is null ? NotFound() : Ok(job.ObterEstado());
+        }
+
+        /// <summary>
+        /// Cancela um job pendente/em execução (202) ou remove um job finalizado (204).
+        /// </summary>
+        [HttpDelete("{id}")]
+        public IActionResult Cancelar(string id)
+        {
+            var job = _jobs.Obter(id);
+            if (job is null) return NotFound();
+            bool ativo = !job.Finalizado;
+            _jobs.CancelarOuRemover(id);
+            return ativo ? Accepted(job.ObterEstado()) : NoContent();
+        }
+    }
+
+    /// <summary>
+    /// Corpo de POST api/jobs: configuração, carga de trabalho e orçamento de ciclos.
+    /// </summary>
+    public class JobRequest
+    {
+        public string? Nome { get; set; }
+        public Configuracoes? Config { get; set; }
+        public long Ciclos { get; set; }
+        public int? RamMB { get; set; }
+
+        /// <summary>Imagem opcional carregada na RAM antes da execução.</summary>
+        public string? ImagemBase64 { get; set; }
+        public int EnderecoCarga { get; set; }
+    }
+}
@@ -0,0 +1,119 @@
+using System.Buffers;
+using System.IO.Compression;
+using Microsoft.AspNetCore.Mvc;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Controllers
+{
+    [ApiController]
+    [Route("api/memory")]
+    public class MemoryController : ControllerBase
+    {
+        private readonly SimulationState _simulation;
+        private readonly SimulationEngine _engine;
+
+        // janela máxima por requisição e tamanho mínimo que compensa comprimir
+        private const int JanelaMaxima = 1024 * 1024;
+        private const int MinimoParaComprimir = 1024;
+
+        public MemoryController(SimulationState simulation, SimulationEngine engine)
+        {
+            _simulation = simulation;
+            _engine = engine;
+        }
+
+        /// <summary>
+        /// Lê uma janela da RAM como bytes crus (<c>application/octet-stream</c>), sem passar pela
+        /// cache. Se o cliente aceitar (<c>Accept-Encoding</c>), a resposta vem comprimida com
+        /// Brotli ou gzip. Janelas que ultrapassam o fim da RAM são truncadas; os cabeçalhos
+        /// <c>X-Ram-Address</c>, <c>X-Ram-Length</c> e <c>X-Ram-Size</c> descrevem o que foi lido.
+        /// </summary>
+        [HttpGet]
+        public async Task<IActionResult> Read([FromQuery] int address = 0, [FromQuery] int length = 256)
+        {
+            var ram = _simulation.Ram;
+            if (address < 0 || address >= ram.TamanhoEmBytes)
+                return BadRequest($"address deve estar entre 0 e {ram.TamanhoEmBytes - 1}.");
+            if (length <= 0 || length > JanelaMaxima)
+                return BadRequest($"length deve estar entre 1 e {JanelaMaxima}.");
+
+            length = Math.Min(length, ram.TamanhoEmBytes - address);
+
+            var buffer = ArrayPool<byte>.Shared.Rent(length);
+            try
+            {
+                ram.Espiar(address, buffer.AsSpan(0, length));
+
+                Response.ContentType = "application/octet-stream";
+                Response.Headers["X-Ram-Address"] = address.ToString();
+                Response.Headers["X-Ram-Length"] = length.ToString();
+                Response.Headers["X-Ram-Size"] = ram.TamanhoEmBytes.ToString();
+                Response.Headers.Vary = "Accept-Encoding";
+
+                var ct = HttpContext.RequestAborted;
+                var codificacao = length >= MinimoParaComprimir ? EscolherCodificacao() : null;
+                if (codificacao is null)
+                {
+                    Response.ContentLength = length;
+                    await Response.Body.WriteAsync(buffer.AsMemory(0, length), ct);
+                }
+                else
+                {
+                    Response.Headers.ContentEncoding = codificacao;
+                    await using Stream compressor = codificacao == "br"
+                        ? new BrotliStream(Response.Body, CompressionLevel.Fastest, leaveOpen: true)
+                        : new GZipStream(Response.Body, CompressionLevel.Fastest, leaveOpen: true);
+                    await compressor.WriteAsync(buffer.AsMemory(0, length), ct);
+                }
+            }
+            finally
+            {
+                ArrayPool<byte>.Shared.Return(buffer);
+            }
+
+            return new EmptyResult();
+        }
+
+        /// <summary>
+        /// Escreve o corpo (<c>application/octet-stream</c>) na RAM a partir de <paramref name="address"/>,
+        /// no ciclo atual. Passa pelo motor para entrar no histórico da depuração reversa.
+        /// </summary>
+        [HttpPut]
+        [RequestSizeLimit(JanelaMaxima)]
+        public async Task<IActionResult> Write([FromQuery] int address = 0)
+        {
+            var ram = _simulation.Ram;
+            using var corpo = new MemoryStream();
+            await Request.Body.CopyToAsync(corpo, HttpContext.RequestAborted);
+            if (corpo.Length == 0 || corpo.Length > JanelaMaxima)
+                return BadRequest($"O corpo deve ter entre 1 e {JanelaMaxima} bytes.");
+            if (address < 0 || (long)address + corpo.Length > ram.TamanhoEmBytes)
+                return BadRequest("A escrita ultrapassa os limites da RAM.");
+
+            _engine.EscreverRam(address, corpo.ToArray());
+            return NoContent();
+        }
+
+        // Brotli tem preferência sobre gzip; "identity" ou ausência do cabeçalho = sem compressão
+        private string? EscolherCodificacao()
+        {
+            var aceitas = Request.Headers.AcceptEncoding.ToString();
+            if (string.IsNullOrEmpty(aceitas)) return null;
+            if (Aceita(aceitas, "br")) return "br";
+            if (Aceita(aceitas, "gzip")) return "gzip";
+            return null;
+        }
+
+        private static bool Aceita(string aceitas, string codificacao)
+        {
+            foreach (var parte in aceitas.Split(',', StringSplitOptions.TrimEntries | StringSplitOptions.RemoveEmptyEntries))
+            {
+                var itens = parte.Split(';', StringSplitOptions.TrimEntries);
+                if (!itens[0].Equals(codificacao, StringComparison.OrdinalIgnoreCase)) continue;
+                // "q=0" recusa explicitamente a codificação
+                return !(itens.Length > 1 && itens[1].Replace(" ", "") is "q=0" or "q=0.0" or "q=0.00" or "q=0.000");
+            }
+            return false;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+using Microsoft.AspNetCore.Mvc;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Controllers
+{
+    /// <summary>
+    /// Depuração reversa da máquina global (ver <see cref="DepuradorReverso"/>): passos para trás,
+    /// ida a um ciclo e breakpoint reverso por PC.
+    /// </summary>
+    [ApiController]
+    [Route("api/simulation/reverse")]
+    public class ReverseController : ControllerBase
+    {
+        private readonly SimulationState _simulation;
+        private readonly SimulationEngine _engine;
+
+        // mesmos limites do avanço em lote (api/simulation/advance) para o goto adiante
+        private const long MaxDelta = 1_000_000_000;
+        private const int TimeoutPadraoMs = 10_000;
+        private const int TimeoutMaximoMs = 60_000;
+
+        public ReverseController(SimulationState simulation, SimulationEngine engine)
+        {
+            _simulation = simulation;
+            _engine = engine;
+        }
+
+        [HttpGet]
+        public ActionResult<StatusDepuracaoReversa> Status()
+        {
+            var reverso = _engine.Reverso;
+            return reverso is null ? NotFound("Depuração reversa desligada.") : Ok(reverso.ObterStatus());
+        }
+
+        /// <summary>
+        /// Liga (ou reinicia) a depuração reversa a partir do ciclo atual. 409 com DMA em andamento.
+        /// </summary>
+        [HttpPost]
+        public ActionResult<StatusDepuracaoReversa> Ativar([FromBody] OpcoesDepuracaoReversa? opcoes)
+        {
+            try
+            {
+                return Ok(_engine.AtivarDepuracaoReversa(opcoes).ObterStatus());
+            }
+            catch (ArgumentException ex)
+            {
+                return BadRequest(ex.Message);
+            }
+            catch (InvalidOperationException ex)
+            {
+                return Conflict(ex.Message);
+            }
+        }
+
+        [HttpDelete]
+        public IActionResult Desativar()
+        {
+            _engine.DesativarDepuracaoReversa();
+            return NoContent();
+        }
+
+        [HttpPost("step-back")]
+        public Task<ActionResult<ResultadoReverso>> StepBack([FromQuery] long ciclos = 1) =>
+            Navegar(r => r.VoltarCiclos(ciclos));
+
+        /// <summary>
+        /// Leva a máquina ao <paramref name="ciclo"/>. Adiante, no máximo <see cref="MaxDelta"/>
+        /// ciclos e interrompido após <paramref name="timeoutMs"/> (Encontrado = false).
+        /// </summary>
+        [HttpPost("goto")]
+        public async Task<ActionResult<ResultadoReverso>> Goto([FromQuery] long ciclo, [FromQuery] int timeoutMs = TimeoutPadraoMs)
+        {
+            if (ciclo - _simulation.CicloAtual > MaxDelta)
+                return BadRequest($"O alvo deve estar no máximo {MaxDelta} ciclos adiante do atual.");
+
+            using var cts = CancellationTokenSource.CreateLinkedTokenSource(HttpContext.RequestAborted);
+            cts.CancelAfter(Math.Clamp(timeoutMs, 1, TimeoutMaximoMs));
+            return await Navegar(r => r.IrPara(ciclo, cts.Token));
+        }
+
+        /// <summary>
+        /// Volta até a última vez, antes do ciclo atual, em que o PC valia <paramref name="pc"/>.
+        /// </summary>
+        [HttpPost("run-back")]
+        public Task<ActionResult<ResultadoReverso>> RunBack([FromQuery] int pc) =>
+            Navegar(r => r.VoltarAtePc(pc));
+
+        private async Task<ActionResult<ResultadoReverso>> Navegar(Func<DepuradorReverso, long?> acao)
+        {
+            var reverso = _engine.Reverso;
+            if (reverso is null) return NotFound("Depuração reversa desligada.");
+            if (_engine.EmExecucao) return Conflict("Pare a execução automática antes de navegar no histórico.");
+
+            try
+            {
+                var atingido = await Task.Run(() => acao(reverso));
+                var snap = _simulation.GetSnapshot();
+                return Ok(new ResultadoReverso(atingido is not null, snap.CicloAtual, snap.Cpu, reverso.ObterStatus()));
+            }
+            catch (ArgumentOutOfRangeException ex)
+            {
+                return BadRequest(ex.Message);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Resposta das navegações de api/simulation/reverse. <c>Encontrado</c> é falso quando o
+    /// breakpoint reverso não ocorreu no histórico retido (a máquina fica onde estava).
+    /// </summary>
+    public record ResultadoReverso(
+        bool Encontrado,
+        long CicloAtual,
+        CpuSnapshot Cpu,
+        StatusDepuracaoReversa Status
+    );
+}
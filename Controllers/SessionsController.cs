@@ -0,0 +1,144 @@
+using System.ComponentModel.DataAnnotations;
+using Microsoft.AspNetCore.Mvc;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Controllers
+{
+    /// <summary>
+    /// Máquinas isoladas por sessão (ver <see cref="PoolSessoes"/>). Cada cliente cria sua
+    /// sessão e passa a usá-la pelo id; a máquina global de api/simulation continua compartilhada.
+    /// </summary>
+    [ApiController]
+    [Route("api/sessions")]
+    public class SessionsController : ControllerBase
+    {
+        private readonly PoolSessoes _pool;
+
+        private const long MaxDelta = 1_000_000_000;
+        private const int TimeoutPadraoMs = 10_000;
+        private const int TimeoutMaximoMs = 60_000;
+
+        public SessionsController(PoolSessoes pool)
+        {
+            _pool = pool;
+        }
+
+        /// <summary>
+        /// Cria uma sessão com a configuração informada (ou a padrão). 503 se o orçamento
+        /// de memória do pool estiver esgotado.
+        /// </summary>
+        [HttpPost]
+        public ActionResult<ResumoSessao> Criar([FromBody] CriarSessaoRequest? request)
+        {
+            try
+            {
+                var sessao = _pool.Criar(request?.Config, request?.RamMB);
+                var resumo = new ResumoSessao(sessao.Id, sessao.CriadaEm, 0, false, sessao.BytesEstimados, 0);
+                return CreatedAtAction(nameof(Snapshot), new { id = sessao.Id }, resumo);
+            }
+            catch (Exception ex) when (ex is ValidationException or ArgumentException)
+            {
+                return BadRequest(ex.Message);
+            }
+            catch (InvalidOperationException ex)
+            {
+                return StatusCode(StatusCodes.Status503ServiceUnavailable, ex.Message);
+            }
+        }
+
+        [HttpGet]
+        public ActionResult<object> Listar()
+        {
+            return Ok(new
+            {
+                quantidade = _pool.Quantidade,
+                bytesEmUso = _pool.BytesEmUso,
+                orcamentoBytes = _pool.Opcoes.OrcamentoBytes,
+                trabalhadores = _pool.Opcoes.Trabalhadores,
+                sessoes = _pool.Listar()
+            });
+        }
+
+        [HttpGet("{id}/snapshot")]
+        public ActionResult<SimulationSnapshot> Snapshot(string id, [FromQuery] int ramPreviewAddress = 0, [FromQuery] int ramPreviewLength = 16)
+        {
+            var sessao = _pool.Obter(id);
+            if (sessao is null) return NotFound();
+            return Ok(sessao.Snapshots.Obter(ramPreviewAddress, ramPreviewLength));
+        }
+
+        /// <summary>
+        /// Executa <paramref name="delta"/> ciclos na máquina da sessão, agendados em quanta
+        /// sobre os trabalhadores compartilhados do pool.
+        /// </summary>
+        [HttpPost("{id}/advance")]
+        public async Task<ActionResult<AdvanceResult>> Advance(string id, [FromQuery] long delta = 1, [FromQuery] int timeoutMs = TimeoutPadraoMs)
+        {
+            var sessao = _pool.Obter(id);
+            if (sessao is null) return NotFound();
+            if (delta <= 0 || delta > MaxDelta)
+                return BadRequest($"delta deve estar entre 1 e {MaxDelta}.");
+
+            using var cts = CancellationTokenSource.CreateLinkedTokenSource(HttpContext.RequestAborted);
+            cts.CancelAfter(Math.Clamp(timeoutMs, 1, TimeoutMaximoMs));
+
+            RunResult run;
+            try
+            {
+                run = await _pool.ExecutarAsync(sessao, delta, cts.Token);
+            }
+            catch (ObjectDisposedException)
+            {
+                // descartada entre a busca e o início da execução
+                return NotFound();
+            }
+            var snap = sessao.Snapshots.Obter();
+
+            return Ok(new AdvanceResult(
+                CiclosSolicitados: delta,
+                CiclosExecutados: run.CiclosExecutados,
+                TempoEsgotado: run.Cancelado && !HttpContext.RequestAborted.IsCancellationRequested,
+                DuracaoMs: run.Duracao.TotalMilliseconds,
+                CiclosPorSegundo: run.CiclosPorSegundo,
+                InstrucoesPorSegundo: run.InstrucoesPorSegundo,
+                CicloAtual: snap.CicloAtual,
+                Cpu: snap.Cpu,
+                Cache: snap.Cache
+            ));
+        }
+
+        [HttpPut("{id}/config")]
+        public ActionResult<ResultadoReconfiguracao> Reconfigurar(string id, [FromBody] Configuracoes config, [FromQuery] bool migrarCache = true)
+        {
+            var sessao = _pool.Obter(id);
+            if (sessao is null) return NotFound();
+            try
+            {
+                return Ok(sessao.Engine.Reconfigurar(config, migrarCache));
+            }
+            catch (Exception ex) when (ex is ValidationException or ArgumentException)
+            {
+                return BadRequest(ex.Message);
+            }
+            catch (InvalidOperationException ex)
+            {
+                return Conflict(ex.Message);
+            }
+        }
+
+        [HttpDelete("{id}")]
+        public IActionResult Remover(string id)
+        {
+            return _pool.Remover(id) ? NoContent() : NotFound();
+        }
+    }
+
+    /// <summary>
+    /// Corpo de POST api/sessions.
+    /// </summary>
+    public class CriarSessaoRequest
+    {
+        public Configuracoes? Config { get; set; }
+        public int? RamMB { get; set; }
+    }
+}
@@ -1,3 +1,7 @@
+using System.Text;
+using System.Text.Json;
+using System.Text.Json.Nodes;
+using Microsoft.AspNetCore.Http.Features;
 using Microsoft.AspNetCore.Mvc;
 using ProjetoSimuladorPC.Utilidades;
 
@@ -8,30 +12,222 @@ namespace ProjetoSimuladorPC.Controllers
     public class SimulationController : ControllerBase
     {
         private readonly SimulationState _simulation;
+        private readonly SimulationEngine _engine;
+        private readonly SnapshotService _snapshots;
 
-        public SimulationController(SimulationState simulation)
+        // limites do avano em lote: protege o host de requisies enormes
+        private const long MaxDelta = 1_000_000_000;
+        private const int TimeoutPadraoMs = 10_000;
+        private const int TimeoutMaximoMs = 60_000;
+
+        // taxa do streaming (eventos por segundo) e intervalo de keep-alive
+        private const int StreamHzPadrao = 10;
+        private const int StreamHzMaximo = 60;
+        private static readonly TimeSpan KeepAlive = TimeSpan.FromSeconds(15);
+
+        public SimulationController(SimulationState simulation, SimulationEngine engine, SnapshotService snapshots)
         {
             _simulation = simulation;
+            _engine = engine;
+            _snapshots = snapshots;
         }
 
         /// <summary>
-        /// Retorna um snapshot do estado da simulao.
+        /// Retorna um snapshot do estado da simulao (compartilhado por verso com a UI).
         /// </summary>
         [HttpGet("snapshot")]
         public ActionResult<SimulationSnapshot> GetSnapshot([FromQuery] int ramPreviewAddress = 0, [FromQuery] int ramPreviewLength = 16)
         {
-            var snap = _simulation.GetSnapshot(ramPreviewAddress, ramPreviewLength);
+            var snap = _snapshots.Obter(ramPreviewAddress, ramPreviewLength);
             return Ok(snap);
         }
 
         /// <summary>
-        /// Avana o clock da simulao. Delta (opcional) indica quantos ciclos avanar (default 1).
+        /// Push de snapshots via Server-Sent Events: um evento "snapshot" com o estado completo
+        /// e, em seguida, eventos "delta" (JSON Merge Patch) apenas com os campos alterados,
+        /// no mximo <paramref name="hz"/> por segundo. Nada  enviado se a verso do estado no mudou.
+        /// </summary>
+        [HttpGet("stream")]
+        public async Task Stream([FromQuery] int hz = StreamHzPadrao, [FromQuery] int ramPreviewLength = 32)
+        {
+            var ct = HttpContext.RequestAborted;
+            hz = Math.Clamp(hz, 1, StreamHzMaximo);
+            ramPreviewLength = Math.Clamp(ramPreviewLength, 0, 4096);
+
+            Response.ContentType = "text/event-stream";
+            Response.Headers.CacheControl = "no-cache";
+            HttpContext.Features.Get<IHttpResponseBodyFeature>()?.DisableBuffering();
+
+            using var timer = new PeriodicTimer(TimeSpan.FromSeconds(1.0 / hz));
+            JsonObject? anterior = null;
+            long versaoEnviada = -1;
+            long id = 0;
+            var ultimoEnvio = DateTime.UtcNow;
+
+            try
+            {
+                do
+                {
+                    long versao = _simulation.Versao;
+                    if (versao != versaoEnviada)
+                    {
+                        versaoEnviada = versao;
+                        var atual = SnapshotDelta.ParaJson(_snapshots.Obter(0, ramPreviewLength));
+
+                        if (anterior is null)
+                        {
+                            await EnviarEventoAsync("snapshot", ++id, atual, ct);
+                            ultimoEnvio = DateTime.UtcNow;
+                        }
+                        else if (SnapshotDelta.Diff(anterior, atual) is { } patch)
+                        {
+                            await EnviarEventoAsync("delta", ++id, patch, ct);
+                            ultimoEnvio = DateTime.UtcNow;
+                        }
+                        anterior = atual;
+                    }
+
+                    if (DateTime.UtcNow - ultimoEnvio >= KeepAlive)
+                    {
+                        await Response.WriteAsync(": keep-alive\n\n", ct);
+                        await Response.Body.FlushAsync(ct);
+                        ultimoEnvio = DateTime.UtcNow;
+                    }
+                }
+                while (await timer.WaitForNextTickAsync(ct));
+            }
+            catch (OperationCanceledException)
+            {
+                // cliente desconectou
+            }
+        }
+
+        private async Task EnviarEventoAsync(string evento, long id, JsonNode dados, CancellationToken ct)
+        {
+            var sb = new StringBuilder();
+            sb.Append("event: ").Append(evento).Append('\n');
+            sb.Append("id: ").Append(id).Append('\n');
+            sb.Append("data: ").Append(dados.ToJsonString(SnapshotDelta.Opcoes)).Append("\n\n");
+            await Response.WriteAsync(sb.ToString(), ct);
+            await Response.Body.FlushAsync(ct);
+        }
+
+        /// <summary>
+        /// Executa <paramref name="delta"/> ciclos reais (CPU, cache, dispositivos) num nico lote
+        /// headless, fora da thread da requisio. O lote  interrompido se o cliente desconectar
+        /// ou aps <paramref name="timeoutMs"/>; a resposta traz os ciclos efetivamente executados,
+        /// a vazo obtida e os contadores finais.
         /// </summary>
         [HttpPost("advance")]
-        public IActionResult Advance([FromQuery] int delta = 1)
+        public async Task<ActionResult<AdvanceResult>> Advance([FromQuery] long delta = 1, [FromQuery] int timeoutMs = TimeoutPadraoMs)
         {
-            _simulation.AdvanceCycle(delta);
-            return Ok();
+            if (delta <= 0 || delta > MaxDelta)
+                return BadRequest($"delta deve estar entre 1 e {MaxDelta}.");
+
+            using var cts = CancellationTokenSource.CreateLinkedTokenSource(HttpContext.RequestAborted);
+            cts.CancelAfter(Math.Clamp(timeoutMs, 1, TimeoutMaximoMs));
+
+            var run = await Task.Run(() => _engine.RunCycles(delta, cts.Token));
+            var snap = _snapshots.Obter();
+
+            return Ok(new AdvanceResult(
+                CiclosSolicitados: delta,
+                CiclosExecutados: run.CiclosExecutados,
+                TempoEsgotado: run.Cancelado && !HttpContext.RequestAborted.IsCancellationRequested,
+                DuracaoMs: run.Duracao.TotalMilliseconds,
+                CiclosPorSegundo: run.CiclosPorSegundo,
+                InstrucoesPorSegundo: run.InstrucoesPorSegundo,
+                CicloAtual: snap.CicloAtual,
+                Cpu: snap.Cpu,
+                Cache: snap.Cache
+            ));
+        }
+
+        /// <summary>
+        /// Assinatura do estado simulado (ver <see cref="SimulationEngine.AssinaturaEstado"/>), para
+        /// comparar execues no modo determinstico.
+        /// </summary>
+        [HttpGet("signature")]
+        public async Task<ActionResult<object>> Assinatura()
+        {
+            var assinatura = await Task.Run(_engine.AssinaturaEstado);
+            return Ok(new { cicloAtual = _simulation.CicloAtual, deterministico = _simulation.Config?.Deterministico ?? false, sha256 = assinatura });
+        }
+
+        // buffer entre o formato de checkpoint (sncrono) e o corpo HTTP
+        private const int BufferCheckpoint = 1024 * 1024;
+
+        /// <summary>
+        /// Baixa um checkpoint completo da mquina (ver <see cref="FormatoCheckpoint"/>).
+        /// 409 com dispositivos paralelos registrados.
+        /// </summary>
+        [HttpGet("checkpoint")]
+        public async Task<IActionResult> Checkpoint([FromQuery] bool comprimir = true)
+        {
+            // grava num arquivo temporrio (a simulao fica bloqueada s durante a gravao local)
+            // e envia depois: um cliente lento no segura o motor nem os leitores da RAM
+            var temporario = new FileStream(Path.GetTempFileName(), FileMode.Open, FileAccess.ReadWrite, FileShare.None,
+                BufferCheckpoint, FileOptions.DeleteOnClose | FileOptions.Asynchronous);
+            try
+            {
+                var info = await Task.Run(() => _engine.SalvarCheckpoint(temporario, comprimir));
+                temporario.Position = 0;
+                // File(...) fecha (e apaga) o temporrio ao terminar o envio
+                return File(temporario, "application/octet-stream", $"simulador-{info.Ciclo}.ckpt");
+            }
+            catch (InvalidOperationException ex)
+            {
+                await temporario.DisposeAsync();
+                return Conflict(ex.Message);
+            }
+            catch
+            {
+                await temporario.DisposeAsync();
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// Restaura a mquina a partir de um checkpoint enviado no corpo (application/octet-stream).
+        /// 400 se o contedo for invlido; 409 se houver transferncia DMA em andamento.
+        /// </summary>
+        [HttpPut("checkpoint")]
+        [DisableRequestSizeLimit]
+        public async Task<ActionResult<InfoCheckpoint>> RestaurarCheckpoint()
+        {
+            HttpContext.Features.Get<IHttpBodyControlFeature>()!.AllowSynchronousIO = true;
+            try
+            {
+                var info = await Task.Run(() =>
+                {
+                    using var entrada = new BufferedStream(Request.Body, BufferCheckpoint);
+                    return _engine.RestaurarCheckpoint(entrada);
+                });
+                return Ok(info);
+            }
+            catch (InvalidDataException ex)
+            {
+                return BadRequest(ex.Message);
+            }
+            catch (InvalidOperationException ex)
+            {
+                return Conflict(ex.Message);
+            }
         }
     }
+
+    /// <summary>
+    /// Resposta de POST api/simulation/advance.
+    /// </summary>
+    public record AdvanceResult(
+        long CiclosSolicitados,
+        long CiclosExecutados,
+        bool TempoEsgotado,
+        double DuracaoMs,
+        double CiclosPorSegundo,
+        double InstrucoesPorSegundo,
+        long CicloAtual,
+        CpuSnapshot Cpu,
+        CacheSnapshot Cache
+    );
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+using System.Text;
+using Microsoft.AspNetCore.Mvc;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Controllers
+{
+    /// <summary>
+    /// Varreduras de parâmetros headless: cada variante roda numa máquina isolada, em paralelo.
+    /// </summary>
+    [ApiController]
+    [Route("api/sweep")]
+    public class SweepController : ControllerBase
+    {
+        // limites para que uma única requisição não monopolize o host
+        private const int MaxVariacoes = 256;
+        private const long MaxCiclosPorVariacao = 100_000_000;
+
+        // cada variante roda com a RAM padrão de SimulationState (1MB)
+        private const long RamPorVariacao = 1024 * 1024;
+
+        /// <summary>
+        /// Executa a grade (produto cartesiano dos eixos) e/ou a lista explícita de variantes.
+        /// formato=csv devolve text/csv; caso contrário, JSON.
+        /// </summary>
+        [HttpPost]
+        public async Task<IActionResult> Executar([FromBody] SweepRequest request, [FromQuery] string formato = "json", CancellationToken ct = default)
+        {
+            if (request.Ciclos <= 0 || request.Ciclos > MaxCiclosPorVariacao)
+                return BadRequest($"Ciclos deve estar entre 1 e {MaxCiclosPorVariacao}.");
+
+            byte[]? imagem = null;
+            if (!string.IsNullOrEmpty(request.ImagemBase64))
+            {
+                try { imagem = Convert.FromBase64String(request.ImagemBase64); }
+                catch (FormatException) { return BadRequest("ImagemBase64 inválida."); }
+                if (request.EnderecoCarga < 0 || (long)request.EnderecoCarga + imagem.Length > RamPorVariacao)
+                    return BadRequest("A imagem não cabe na RAM a partir de EnderecoCarga.");
+            }
+
+            var variacoes = new List<VariacaoSweep>();
+            if (request.Variacoes is { Count: > 0 })
+            {
+                for (int i = 0; i < request.Variacoes.Count; i++)
+                    variacoes.Add(new VariacaoSweep($"v{i}", request.Variacoes[i]));
+            }
+            if (request.Variacoes is not { Count: > 0 } || request.TemEixos)
+            {
+                try
+                {
+                    variacoes.AddRange(SweepRunner.Grade(request.Base ?? new Configuracoes(),
+                        request.L1Sizes, request.L1Assocs, request.L1LineSizes, request.L1WritePolicies, request.TimerPeriods));
+                }
+                catch (ArgumentException ex)
+                {
+                    return BadRequest(ex.Message);
+                }
+            }
+
+            if (variacoes.Count > MaxVariacoes)
+                return BadRequest($"A varredura gera {variacoes.Count} variantes (máximo {MaxVariacoes}).");
+
+            var carga = new CargaTrabalho(request.Nome ?? "padrao", request.Ciclos, imagem, request.EnderecoCarga);
+            var resultados = await SweepRunner.ExecutarAsync(variacoes, carga, request.Paralelismo, ct);
+
+            if (string.Equals(formato, "csv", StringComparison.OrdinalIgnoreCase))
+            {
+                var sb = new StringBuilder();
+                using (var w = new StringWriter(sb)) SweepRunner.EscreverCsv(w, resultados);
+                return Content(sb.ToString(), "text/csv", Encoding.UTF8);
+            }
+            return Ok(resultados);
+        }
+    }
+
+    /// <summary>
+    /// Corpo de POST api/sweep: configuração base + eixos da grade e/ou variantes explícitas.
+    /// </summary>
+    public class SweepRequest
+    {
+        public string? Nome { get; set; }
+        public long Ciclos { get; set; } = 1_000_000;
+        public int? Paralelismo { get; set; }
+
+        public Configuracoes? Base { get; set; }
+        public List<string>? L1Sizes { get; set; }
+        public List<int>? L1Assocs { get; set; }
+        public List<int>? L1LineSizes { get; set; }
+        public List<string>? L1WritePolicies { get; set; }
+        public List<int>? TimerPeriods { get; set; }
+
+        public List<Configuracoes>? Variacoes { get; set; }
+
+        /// <summary>Imagem opcional carregada na RAM de cada variante antes da execução.</summary>
+        public string? ImagemBase64 { get; set; }
+        public int EnderecoCarga { get; set; }
+
+        internal bool TemEixos =>
+            L1Sizes is { Count: > 0 } || L1Assocs is { Count: > 0 } || L1LineSizes is { Count: > 0 }
+            || L1WritePolicies is { Count: > 0 } || TimerPeriods is { Count: > 0 };
+    }
+}
@@ -0,0 +1,136 @@
+using Microsoft.AspNetCore.Mvc;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Controllers
+{
+    /// <summary>
+    /// Trace de execução da máquina global (ver <see cref="FormatoTrace"/>), gravado num arquivo
+    /// temporário do servidor e baixado ao final.
+    /// </summary>
+    [ApiController]
+    [Route("api/simulation/trace")]
+    public class TraceController : ControllerBase
+    {
+        private readonly SimulationEngine _engine;
+
+        // último trace gravado: um arquivo por gravação, para que um novo início não sobrescreva
+        // um download em andamento nem o trace de outra instância do servidor
+        private static string? _arquivo;
+
+        public TraceController(SimulationEngine engine)
+        {
+            _engine = engine;
+        }
+
+        /// <summary>
+        /// Começa a gravar. 409 se já houver um trace em andamento.
+        /// </summary>
+        [HttpPost]
+        public IActionResult Iniciar([FromQuery] bool comprimir = true)
+        {
+            if (_engine.TraceAtivo) return Conflict("Já existe um trace em andamento.");
+            var caminho = Path.Combine(Path.GetTempPath(), $"simulador-trace-{Guid.NewGuid():N}.simtrace");
+            try
+            {
+                var arquivo = new FileStream(caminho, FileMode.CreateNew, FileAccess.Write, FileShare.Read, 1 << 20);
+                try
+                {
+                    _engine.IniciarTrace(arquivo, comprimir, manterAberto: false);
+                }
+                catch
+                {
+                    arquivo.Dispose();
+                    System.IO.File.Delete(caminho);
+                    throw;
+                }
+                ApagarTrace(Interlocked.Exchange(ref _arquivo, caminho));
+                return Accepted();
+            }
+            catch (InvalidOperationException ex)
+            {
+                return Conflict(ex.Message);
+            }
+        }
+
+        /// <summary>
+        /// Encerra a gravação e retorna o resumo. 404 se não havia trace.
+        /// </summary>
+        [HttpDelete]
+        public async Task<ActionResult<ResumoTrace>> Parar()
+        {
+            try
+            {
+                var resumo = await Task.Run(_engine.PararTrace);
+                return resumo is null ? NotFound() : Ok(resumo);
+            }
+            catch (IOException ex)
+            {
+                return StatusCode(StatusCodes.Status500InternalServerError, ex.Message);
+            }
+        }
+
+        /// <summary>
+        /// Baixa o último trace encerrado. 409 enquanto a gravação estiver em andamento.
+        /// </summary>
+        [HttpGet]
+        public IActionResult Baixar()
+        {
+            if (_engine.TraceAtivo) return Conflict("Trace em andamento: encerre antes de baixar.");
+            var arquivo = Volatile.Read(ref _arquivo);
+            if (arquivo is null || !System.IO.File.Exists(arquivo)) return NotFound();
+            return PhysicalFile(arquivo, "application/octet-stream", "simulador.simtrace");
+        }
+
+        // o trace anterior deixa de ser servido; um download dele em andamento mantém o arquivo
+        // aberto (no Windows a remoção falha e o temporário fica para a limpeza do sistema)
+        private static void ApagarTrace(string? caminho)
+        {
+            if (caminho is null) return;
+            try
+            {
+                System.IO.File.Delete(caminho);
+            }
+            catch (Exception ex) when (ex is IOException or UnauthorizedAccessException)
+            {
+            }
+        }
+
+        /// <summary>
+        /// Reproduz um trace numa cache isolada, sem executar a CPU nem alterar a máquina (ver
+        /// <see cref="SimulationEngine.ReproduzirTrace"/>). O corpo é um trace binário ou uma lista
+        /// de endereços em texto; com <paramref name="ultimo"/>, usa o último trace gravado.
+        /// </summary>
+        [HttpPost("replay")]
+        public async Task<ActionResult<ResultadoReproducao>> Reproduzir([FromQuery] bool ultimo = false, CancellationToken ct = default)
+        {
+            var arquivo = Volatile.Read(ref _arquivo);
+            if (ultimo && (_engine.TraceAtivo || arquivo is null || !System.IO.File.Exists(arquivo)))
+                return NotFound("Nenhum trace gravado disponível.");
+
+            // o corpo é copiado para um temporário (apagado ao fechar): os leitores são síncronos
+            Stream origem = ultimo
+                ? new FileStream(arquivo!, FileMode.Open, FileAccess.Read, FileShare.Read | FileShare.Delete, 1 << 20)
+                : new FileStream(Path.GetTempFileName(), FileMode.Open, FileAccess.ReadWrite, FileShare.None,
+                    1 << 20, FileOptions.DeleteOnClose);
+            try
+            {
+                if (!ultimo)
+                {
+                    await Request.Body.CopyToAsync(origem, ct);
+                    origem.Position = 0;
+                }
+
+                using var fonte = ReprodutorTrace.AbrirFonte(origem);
+                return Ok(await Task.Run(() => _engine.ReproduzirTrace(fonte, ct)));
+            }
+            catch (InvalidDataException ex)
+            {
+                return BadRequest(ex.Message);
+            }
+            finally
+            {
+                origem.Dispose();
+            }
+        }
+    }
+}
@@ -1,5 +1,6 @@
 using System.Threading.Tasks;
 using ProjetoSimuladorPC.RAM;
+using ProjetoSimuladorPC.Utilidades;
 
 namespace ProjetoSimuladorPC.DMA
 {
@@ -15,11 +16,102 @@ namespace ProjetoSimuladorPC.DMA
 
         private readonly object _sync = new();
 
-        public DMA(RamState ram, DispositivoMMIO dispositivo, DmaState state)
+        // modo dirigido por ciclos: rajadas agendadas na fila de eventos do motor
+        private readonly EventScheduler? _agenda;
+        private EventoAgendado? _proximaRajada;
+
+        public DMA(RamState ram, DispositivoMMIO dispositivo, DmaState state, EventScheduler? agenda = null)
         {
             _ram = ram;
             _dispositivo = dispositivo;
             _state = state;
+            _agenda = agenda;
+        }
+
+        /// <summary>Bytes copiados por rajada no modo dirigido por ciclos.</summary>
+        public int BytesPorRajada { get; set; } = 16;
+
+        /// <summary>Ciclos de simulação entre rajadas no modo dirigido por ciclos.</summary>
+        public int CiclosPorRajada { get; set; } = 8;
+
+        /// <summary>
+        /// Verdadeiro se a transferência em andamento avança pelos ciclos da simulação.
+        /// </summary>
+        public bool DirigidaPorCiclos => _proximaRajada is { Cancelado: false };
+
+        /// <summary>
+        /// Inicia uma transferência que avança pelo ciclo da simulação, não pelo relógio do host:
+        /// a cada <see cref="CiclosPorRajada"/> ciclos copia até <see cref="BytesPorRajada"/> bytes.
+        /// O resultado depende só do ciclo de início, logo é reprodutível. Exige a fila de eventos.
+        /// </summary>
+        public void IniciarTransferenciaPorCiclos(int origem, int destino, int tamanho, long cicloAtual)
+        {
+            if (_agenda is null) throw new InvalidOperationException("DMA sem fila de eventos.");
+            lock (_sync)
+            {
+                if (_state.EmExecucao)
+                {
+                    _state.Fail("Já existe uma transferência em andamento");
+                    return;
+                }
+                _state.Start(origem, destino, tamanho);
+            }
+            AgendarRajada(cicloAtual + CiclosPorRajada);
+        }
+
+        /// <summary>
+        /// Continua pelos ciclos uma transferência restaurada (DmaState em execução) sem agenda gravada.
+        /// </summary>
+        public void RetomarTransferenciaPorCiclos(long cicloAtual)
+        {
+            if (_state.EmExecucao && !DirigidaPorCiclos) AgendarRajada(cicloAtual + CiclosPorRajada);
+        }
+
+        /// <summary>
+        /// Grava o ciclo da próxima rajada (-1 se não houver) num checkpoint.
+        /// </summary>
+        public void SalvarAgenda(BinaryWriter w) => w.Write(_proximaRajada is { Cancelado: false } p ? p.Ciclo : -1L);
+
+        /// <summary>
+        /// Reagenda a próxima rajada no ciclo absoluto gravado por <see cref="SalvarAgenda"/>.
+        /// </summary>
+        public void RestaurarAgenda(BinaryReader r)
+        {
+            _agenda?.Cancelar(_proximaRajada);
+            _proximaRajada = null;
+            long proxima = r.ReadInt64();
+            if (proxima >= 0 && _state.EmExecucao) AgendarRajada(proxima);
+        }
+
+        private void AgendarRajada(long ciclo) => _proximaRajada = _agenda!.Agendar(ciclo, Rajada, "dma");
+
+        private void Rajada(long ciclo)
+        {
+            _proximaRajada = null;
+            var s = _state.GetSnapshot();
+            if (!s.EmExecucao) return;
+
+            int fim = Math.Min(s.Tamanho, s.BytesTransferidos + Math.Max(1, BytesPorRajada));
+            try
+            {
+                for (int i = s.BytesTransferidos; i < fim; i++) CopiarByte(s.Origem + i, s.Destino + i);
+            }
+            catch (Exception ex)
+            {
+                _state.Fail($"Falha na transferência: {ex.Message}");
+                return;
+            }
+
+            _state.ReportProgress(fim);
+            if (fim >= s.Tamanho) _state.Complete();
+            else AgendarRajada(ciclo + Math.Max(1, CiclosPorRajada));
+        }
+
+        private void CopiarByte(int origem, int destino)
+        {
+            byte dado = _ram.Ler(origem);
+            if (_dispositivo.EstaNaFaixa(destino)) _dispositivo.ReceberDado(dado);
+            else _ram.Escrever(destino, dado);
         }
 
         /// <summary>
@@ -37,10 +129,26 @@ namespace ProjetoSimuladorPC.DMA
                 _state.Start(origem, destino, tamanho);
             }
 
-            int transferidos = 0;
+            await TransferirAsync(origem, destino, tamanho, 0, delayMs).ConfigureAwait(false);
+        }
+
+        /// <summary>
+        /// Continua uma transferência restaurada de um checkpoint (DmaState em execução) a partir
+        /// do byte em que parou.
+        /// </summary>
+        public Task RetomarTransferenciaAsync(int delayMs = 10)
+        {
+            var s = _state.GetSnapshot();
+            if (!s.EmExecucao) return Task.CompletedTask;
+            return TransferirAsync(s.Origem, s.Destino, s.Tamanho, s.BytesTransferidos, delayMs);
+        }
+
+        private async Task TransferirAsync(int origem, int destino, int tamanho, int inicio, int delayMs)
+        {
+            int transferidos = inicio;
             try
             {
-                for (int i = 0; i < tamanho; i++)
+                for (int i = inicio; i < tamanho; i++)
                 {
                     // Ler 1 byte da RAM (pode lançar se fora dos limites)
                     byte dado = _ram.Ler(origem + i);
@@ -19,11 +19,18 @@ namespace ProjetoSimuladorPC.DMA
         public int Tamanho { get; private set; }
         public int BytesTransferidos { get; private set; }
 
+        // Total acumulado de bytes transferidos desde a criação (base para vazão)
+        private long _totalBytes;
+        public long TotalBytesTransferidos => Interlocked.Read(ref _totalBytes);
+
         // Timestamps e mensagens de status para a UI
         public DateTime? Inicio { get; private set; }
         public DateTime? Fim { get; private set; }
         public string? Mensagem { get; private set; }
 
+        // último snapshot entregue; descartado a cada mudança (leituras repetidas não alocam)
+        private DmaSnapshot? _snapshot;
+
         // Evento para notificar a UI (Blazor) sobre mudanças no estado
         public event EventHandler? StateChanged;
 
@@ -31,6 +38,7 @@ namespace ProjetoSimuladorPC.DMA
         {
             lock (_sync)
             {
+                _snapshot = null;
                 EmExecucao = true;
                 TransferenciaConcluida = false;
                 Origem = origem;
@@ -48,6 +56,12 @@ namespace ProjetoSimuladorPC.DMA
         {
             lock (_sync)
             {
+                _snapshot = null;
+                if (bytes > BytesTransferidos)
+                {
+                    Interlocked.Add(ref _totalBytes, bytes - BytesTransferidos);
+                    ProjetoSimuladorPC.Utilidades.SimuladorEventSource.Log.DmaTransferiu(bytes - BytesTransferidos);
+                }
                 BytesTransferidos = bytes;
             }
             StateChanged?.Invoke(this, EventArgs.Empty);
@@ -57,6 +71,7 @@ namespace ProjetoSimuladorPC.DMA
         {
             lock (_sync)
             {
+                _snapshot = null;
                 Mensagem = mensagem;
             }
             StateChanged?.Invoke(this, EventArgs.Empty);
@@ -66,6 +81,7 @@ namespace ProjetoSimuladorPC.DMA
         {
             lock (_sync)
             {
+                _snapshot = null;
                 EmExecucao = false;
                 TransferenciaConcluida = true;
                 Fim = DateTime.UtcNow;
@@ -78,6 +94,7 @@ namespace ProjetoSimuladorPC.DMA
         {
             lock (_sync)
             {
+                _snapshot = null;
                 EmExecucao = false;
                 TransferenciaConcluida = false;
                 Fim = DateTime.UtcNow;
@@ -86,6 +103,50 @@ namespace ProjetoSimuladorPC.DMA
             StateChanged?.Invoke(this, EventArgs.Empty);
         }
 
+        /// <summary>
+        /// Grava a transferência atual (progresso inclusive) e o total acumulado num checkpoint.
+        /// </summary>
+        public void SalvarEstado(BinaryWriter w)
+        {
+            lock (_sync)
+            {
+                w.Write(EmExecucao);
+                w.Write(TransferenciaConcluida);
+                w.Write(Origem);
+                w.Write(Destino);
+                w.Write(Tamanho);
+                w.Write(BytesTransferidos);
+                w.Write(Inicio?.Ticks ?? -1L);
+                w.Write(Fim?.Ticks ?? -1L);
+                w.Write(Mensagem ?? string.Empty);
+                w.Write(Interlocked.Read(ref _totalBytes));
+            }
+        }
+
+        /// <summary>
+        /// Restaura o estado gravado por <see cref="SalvarEstado"/>. Uma transferência que estava
+        /// em andamento volta marcada como em execução; cabe ao DMA retomá-la.
+        /// </summary>
+        public void RestaurarEstado(BinaryReader r)
+        {
+            lock (_sync)
+            {
+                _snapshot = null;
+                EmExecucao = r.ReadBoolean();
+                TransferenciaConcluida = r.ReadBoolean();
+                Origem = r.ReadInt32();
+                Destino = r.ReadInt32();
+                Tamanho = r.ReadInt32();
+                BytesTransferidos = r.ReadInt32();
+                long inicio = r.ReadInt64(), fim = r.ReadInt64();
+                Inicio = inicio >= 0 ? new DateTime(inicio, DateTimeKind.Utc) : null;
+                Fim = fim >= 0 ? new DateTime(fim, DateTimeKind.Utc) : null;
+                Mensagem = r.ReadString();
+                Interlocked.Exchange(ref _totalBytes, r.ReadInt64());
+            }
+            StateChanged?.Invoke(this, EventArgs.Empty);
+        }
+
         /// <summary>
         /// Retorna um snapshot simples (imutável) do estado atual para renderização.
         /// </summary>
@@ -93,7 +154,7 @@ namespace ProjetoSimuladorPC.DMA
         {
             lock (_sync)
             {
-                return new DmaSnapshot(
+                return _snapshot ??= new DmaSnapshot(
                     EmExecucao,
                     TransferenciaConcluida,
                     Origem,
@@ -0,0 +1,88 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimuladorPC.Dispositivos
+{
+    /// <summary>
+    /// Console serial (estilo UART) simulado fora da thread do motor: os bytes escritos no
+    /// registrador de dados entram numa FIFO e são transmitidos a um a cada
+    /// <see cref="CiclosPorByte"/> ciclos. Quando a FIFO esvazia, levanta <see cref="VetorIrq"/>
+    /// (se habilitada no registrador de controle).
+    /// </summary>
+    public sealed class DispositivoConsole : DispositivoParalelo
+    {
+        public const int RegistroDados = 0;
+        public const int RegistroControle = 1; // bit 0 = IRQ de transmissão habilitada
+
+        public const int TamanhoFifo = 16;
+
+        readonly Queue<byte> fifo = new();
+        readonly List<byte> transmitidos = new();
+        EventoAgendado? proximo;
+
+        public DispositivoConsole(string nome = "console", int ciclosPorByte = 1_000, int vetorIrq = 1, long latenciaCiclos = 256)
+            : base(nome, latenciaCiclos)
+        {
+            if (ciclosPorByte <= 0) throw new ArgumentOutOfRangeException(nameof(ciclosPorByte), "Ciclos por byte deve ser positivo.");
+            CiclosPorByte = ciclosPorByte;
+            VetorIrq = vetorIrq;
+        }
+
+        public int CiclosPorByte { get; }
+        public int VetorIrq { get; }
+        public bool IrqHabilitada { get; private set; }
+
+        /// <summary>Bytes descartados por FIFO cheia.</summary>
+        public long Perdidos { get; private set; }
+
+        protected override void Receber(in MensagemDispositivo mensagem)
+        {
+            switch (mensagem.Endereco)
+            {
+                case RegistroDados:
+                    if (fifo.Count >= TamanhoFifo)
+                    {
+                        Perdidos++;
+                        return;
+                    }
+                    fifo.Enqueue((byte)mensagem.Valor);
+                    proximo ??= Agenda.Agendar(CicloLocal + CiclosPorByte, Transmitir, "console");
+                    break;
+                case RegistroControle:
+                    IrqHabilitada = (mensagem.Valor & 1) != 0;
+                    break;
+            }
+        }
+
+        void Transmitir(long ciclo)
+        {
+            transmitidos.Add(fifo.Dequeue());
+            if (fifo.Count > 0)
+            {
+                proximo = Agenda.Agendar(ciclo + CiclosPorByte, Transmitir, "console");
+                return;
+            }
+
+            proximo = null;
+            if (IrqHabilitada) EnviarIrq(VetorIrq);
+        }
+
+        public override void SalvarEstado(BinaryWriter w)
+        {
+            w.Write(CiclosPorByte);
+            w.Write(IrqHabilitada);
+            w.Write(Perdidos);
+            w.Write(proximo?.Ciclo ?? -1L);
+            w.Write(fifo.Count);
+            foreach (var b in fifo) w.Write(b);
+            w.Write(transmitidos.Count);
+            w.Write(transmitidos.ToArray());
+        }
+
+        /// <summary>Texto já transmitido (Latin-1).</summary>
+        public override string Resumo() => Encoding.Latin1.GetString(transmitidos.ToArray());
+    }
+}
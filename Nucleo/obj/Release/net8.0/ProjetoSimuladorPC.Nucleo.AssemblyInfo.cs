@@ -0,0 +1,25 @@
+//------------------------------------------------------------------------------
+// <auto-generated>
+//     This code was generated by a tool.
+//
+//     Changes to this file may cause incorrect behavior and will be lost if
+//     the code is regenerated.
+// </auto-generated>
+//------------------------------------------------------------------------------
+
+using System;
+using System.Reflection;
+
+[assembly: System.Reflection.AssemblyCompanyAttribute("ProjetoSimuladorPC.Nucleo")]
+[assembly: System.Reflection.AssemblyConfigurationAttribute("Release")]
+[assembly: System.Reflection.AssemblyFileVersionAttribute("1.0.0.0")]
+[assembly: System.Reflection.AssemblyInformationalVersionAttribute("1.0.0+d2fa08c8f02197d6b405ebf5454d2301571620fc")]
+[assembly: System.Reflection.AssemblyProductAttribute("ProjetoSimuladorPC.Nucleo")]
+[assembly: System.Reflection.AssemblyTitleAttribute("ProjetoSimuladorPC.Nucleo")]
+[assembly: System.Reflection.AssemblyVersionAttribute("1.0.0.0")]
+[assembly: System.Runtime.CompilerServices.InternalsVisibleTo("ProjetoSimuladorPC")]
+[assembly: System.Runtime.CompilerServices.InternalsVisibleTo("ProjetoSimuladorPC.Benchmarks")]
+[assembly: System.Runtime.CompilerServices.InternalsVisibleTo("ProjetoSimuladorPC.Cli")]
+
+// Generated by the MSBuild WriteCodeFragment class.
+
@@ -1,6 +1,4 @@
 using System;
-using System.Linq;
-using System.Net.Http;
 using ProjetoSimuladorPC.Components;
 using ProjetoSimuladorPC.Utilidades;
 using Microsoft.Extensions.DependencyInjection;
@@ -19,33 +17,28 @@ builder.Services.AddSingleton<SimulationEngine>(sp =>
 {
     var sim = sp.GetRequiredService<SimulationState>();
     var engine = new SimulationEngine(sim);
+    // s a mquina compartilhada amostra desempenho desde a partida (painel e /metrics)
+    _ = engine.Desempenho;
     return engine;
 });
 
-// Habilitar controllers para endpoints REST usados pela UI
-builder.Services.AddControllers();
+// snapshots versionados em processo, compartilhados por todos os circuitos Blazor e pela API
+builder.Services.AddSingleton<SnapshotService>();
 
-// Registrar HttpClient com BaseAddress razovel para chamadas ao prprio backend.
-// Tenta ler uma URL em "ServerBaseUrl" ou "ASPNETCORE_URLS", caso contrrio usa um fallback.
-builder.Services.AddHttpClient("server", client =>
-{
-    var baseUrl = builder.Configuration["ServerBaseUrl"];
-    if (string.IsNullOrEmpty(baseUrl))
-    {
-        var urls = builder.Configuration["ASPNETCORE_URLS"];
-        if (!string.IsNullOrEmpty(urls))
-            baseUrl = urls.Split(';', StringSplitOptions.RemoveEmptyEntries).First();
-        else
-            baseUrl = "https://localhost:5001";
-    }
-
-    // garante que termine com barra
-    if (!baseUrl.EndsWith("/")) baseUrl += "/";
-    client.BaseAddress = new Uri(baseUrl);
-});
+// mquinas isoladas por sesso (API api/sessions e painel com ?sessao=); limites em "PoolSessoes"
+builder.Services.AddSingleton(_ => new PoolSessoes(
+    builder.Configuration.GetSection("PoolSessoes").Get<OpcoesPoolSessoes>() ?? new OpcoesPoolSessoes()));
+
+// jobs longos em segundo plano (api/jobs); limites em "Jobs"
+builder.Services.AddSingleton(_ => new GerenciadorJobs(
+    builder.Configuration.GetSection("Jobs").Get<OpcoesJobs>() ?? new OpcoesJobs()));
+builder.Services.AddHostedService(sp => sp.GetRequiredService<GerenciadorJobs>());
 
-// Resolve HttpClient in components when injecting HttpClient (scoped)
-builder.Services.AddScoped(sp => sp.GetRequiredService<IHttpClientFactory>().CreateClient("server"));
+// exposio Prometheus dos contadores (buffer pr-alocado, sem locks da simulao)
+builder.Services.AddSingleton<MetricasPrometheus>();
+
+// Habilitar controllers para endpoints REST usados pela UI
+builder.Services.AddControllers();
 
 var app = builder.Build();
 
@@ -65,6 +58,13 @@ app.UseAntiforgery();
 // Mapear controllers (API)
 app.MapControllers();
 
+// Mtricas no formato texto do Prometheus
+app.MapGet("/metrics", async (HttpContext ctx, MetricasPrometheus metricas) =>
+{
+    ctx.Response.ContentType = MetricasPrometheus.ContentType;
+    await metricas.EscreverAsync(ctx.Response.Body, ctx.RequestAborted);
+});
+
 // Mapear Blazor components
 app.MapRazorComponents<App>()
     .AddInteractiveServerRenderMode();
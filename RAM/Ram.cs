@@ -43,6 +43,46 @@ namespace ProjetoSimuladorPC.RAM
             return buffer;
         }
 
+        // Copia um bloco para o destino informado, sem alocar.
+        public void CopiarPara(int endereco, Span<byte> destino)
+        {
+            if (endereco < 0 || endereco + destino.Length > memoria.Length)
+                throw new ArgumentOutOfRangeException(nameof(endereco), $"Leitura fora dos limites: endereço={endereco}, comprimento={destino.Length}.");
+
+            memoria.AsSpan(endereco, destino.Length).CopyTo(destino);
+        }
+
+        // Acesso direto ao conteúdo (checkpoints); o chamador garante a exclusão mútua.
+        // Escritas diretas não marcam páginas alteradas.
+        internal byte[] Memoria => memoria;
+
+        // Rastreamento de páginas alteradas (depuração reversa): um bit por página de 4 KiB,
+        // marcado pelas escritas; null quando desligado.
+        internal const int BitsPaginaRastreada = 12;
+        private ulong[]? alteradas;
+
+        internal int PaginasRastreadas => (int)(((long)memoria.Length + (1 << BitsPaginaRastreada) - 1) >> BitsPaginaRastreada);
+
+        internal void RastrearAlteracoes(bool ativo) =>
+            alteradas = ativo ? new ulong[(PaginasRastreadas + 63) / 64] : null;
+
+        // devolve as páginas alteradas desde a coleta anterior e recomeça do zero
+        internal ulong[]? ColetarAlteradas()
+        {
+            var atual = alteradas;
+            if (atual is null) return null;
+            alteradas = new ulong[atual.Length];
+            return atual;
+        }
+
+        private void MarcarAlteradas(int endereco, int comprimento)
+        {
+            var bits = alteradas;
+            if (bits is null || comprimento <= 0) return;
+            int ultima = (endereco + comprimento - 1) >> BitsPaginaRastreada;
+            for (int p = endereco >> BitsPaginaRastreada; p <= ultima; p++) bits[p >> 6] |= 1UL << p;
+        }
+
         // Métodos auxiliares de escrita para facilitar testes e uso.
         public void Escrever(int endereco, byte valor)
         {
@@ -50,6 +90,7 @@ namespace ProjetoSimuladorPC.RAM
                 throw new ArgumentOutOfRangeException(nameof(endereco));
 
             memoria[endereco] = valor;
+            MarcarAlteradas(endereco, 1);
         }
 
         public void Escrever(int endereco, byte[] dados)
@@ -59,6 +100,7 @@ namespace ProjetoSimuladorPC.RAM
                 throw new ArgumentOutOfRangeException(nameof(endereco));
 
             Array.Copy(dados, 0, memoria, endereco, dados.Length);
+            MarcarAlteradas(endereco, dados.Length);
         }
     }
 }
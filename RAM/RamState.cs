@@ -1,5 +1,6 @@
 ﻿using System;
 using ProjetoSimuladorPC.Cache;
+using ProjetoSimuladorPC.Utilidades;
 
 namespace ProjetoSimuladorPC.RAM
 {
@@ -16,6 +17,9 @@ namespace ProjetoSimuladorPC.RAM
         // cache opcional (pode ser anexada em tempo de execução)
         private ProjetoSimuladorPC.Cache.Cache? _cache;
 
+        // rastreamento opcional de acessos (trace)
+        private IObservadorExecucao? _observador;
+
         public event EventHandler<MemoryChangedEventArgs>? MemoryChanged;
 
         public int TamanhoEmBytes => _ram.TamanhoEmBytes;
@@ -33,7 +37,65 @@ namespace ProjetoSimuladorPC.RAM
         /// </summary>
         public void AttachCache(ProjetoSimuladorPC.Cache.Cache cache)
         {
-            _cache = cache ?? throw new ArgumentNullException(nameof(cache));
+            if (cache is null) throw new ArgumentNullException(nameof(cache));
+
+            // troca sob o lock: nenhum acesso em andamento usa a cache antiga
+            lock (_sync)
+            {
+                _cache = cache;
+            }
+        }
+
+        /// <summary>
+        /// Observador notificado de cada leitura/escrita que passa pela cache (não de
+        /// <see cref="Espiar(int, Span{byte})"/>). Chamado sob o lock da RAM.
+        /// </summary>
+        public IObservadorExecucao? Observador
+        {
+            get => _observador;
+            set
+            {
+                lock (_sync)
+                {
+                    _observador = value;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Executa <paramref name="acao"/> sobre o conteúdo bruto da RAM com os acessos bloqueados
+        /// (checkpoints). Não passa pela cache nem dispara <see cref="MemoryChanged"/>.
+        /// </summary>
+        internal void ComMemoria(Action<byte[]> acao)
+        {
+            lock (_sync)
+            {
+                acao(_ram.Memoria);
+            }
+        }
+
+        /// <summary>
+        /// Liga/desliga o rastreamento de páginas (4 KiB) alteradas por escritas.
+        /// </summary>
+        internal void RastrearAlteracoes(bool ativo)
+        {
+            lock (_sync)
+            {
+                _ram.RastrearAlteracoes(ativo);
+            }
+        }
+
+        internal int PaginasRastreadas => _ram.PaginasRastreadas;
+
+        /// <summary>
+        /// Bitmap das páginas alteradas desde a coleta anterior (null se o rastreamento está desligado).
+        /// </summary>
+        internal ulong[]? ColetarAlteradas()
+        {
+            lock (_sync)
+            {
+                return _ram.ColetarAlteradas();
+            }
         }
 
         /// <summary>
@@ -45,7 +107,9 @@ namespace ProjetoSimuladorPC.RAM
             {
                 // registra acesso na cache (apenas estatísticas aqui)
                 try { _cache?.Access((uint)endereco, false); } catch { }
+                _observador?.Acesso(endereco, 1, false);
 
+                SimuladorEventSource.Log.RamLida(1);
                 return _ram.Ler(endereco);
             }
         }
@@ -59,7 +123,9 @@ namespace ProjetoSimuladorPC.RAM
             {
                 // registra um acesso de bloco como um único acesso (ajuste se desejar granularidade)
                 try { _cache?.Access((uint)endereco, false); } catch { }
+                _observador?.Acesso(endereco, comprimento, false);
 
+                SimuladorEventSource.Log.RamLida(comprimento);
                 return _ram.Ler(endereco, comprimento);
             }
         }
@@ -81,6 +147,34 @@ namespace ProjetoSimuladorPC.RAM
             }
         }
 
+        /// <summary>
+        /// Lê um bloco para <paramref name="destino"/> sem passar pela cache: usado por
+        /// visualizadores (preview, hex viewer, API) para não alterar estatísticas nem o estado LRU.
+        /// </summary>
+        public void Espiar(int endereco, Span<byte> destino)
+        {
+            lock (_sync)
+            {
+                _ram.CopiarPara(endereco, destino);
+            }
+        }
+
+        /// <summary>
+        /// Versão alocante de <see cref="Espiar(int, Span{byte})"/>; retorna falso fora dos limites.
+        /// </summary>
+        public bool TryEspiar(int endereco, int comprimento, out byte[] dados)
+        {
+            if (comprimento < 0 || endereco < 0 || (long)endereco + comprimento > TamanhoEmBytes)
+            {
+                dados = Array.Empty<byte>();
+                return false;
+            }
+
+            dados = comprimento == 0 ? Array.Empty<byte>() : new byte[comprimento];
+            Espiar(endereco, dados);
+            return true;
+        }
+
         /// <summary>
         /// Escreve um único byte e notifica assinantes.
         /// </summary>
@@ -90,8 +184,10 @@ namespace ProjetoSimuladorPC.RAM
             {
                 // registra escrita na cache
                 try { _cache?.Access((uint)endereco, true); } catch { }
+                _observador?.Acesso(endereco, 1, true);
 
                 _ram.Escrever(endereco, valor);
+                SimuladorEventSource.Log.RamEscrita(1);
                 OnMemoryChanged(endereco, new[] { valor });
             }
         }
@@ -107,8 +203,10 @@ namespace ProjetoSimuladorPC.RAM
             {
                 // registra escrita de bloco como um único acesso (ajuste se desejar granularidade)
                 try { _cache?.Access((uint)endereco, true); } catch { }
+                _observador?.Acesso(endereco, dados.Length, true);
 
                 _ram.Escrever(endereco, dados);
+                SimuladorEventSource.Log.RamEscrita(dados.Length);
                 OnMemoryChanged(endereco, dados);
             }
         }
@@ -0,0 +1,104 @@
+using System;
+using ProjetoSimuladorPC.Utilidades;
+
+namespace ProjetoSimIO.Core
+{
+    /// <summary>
+    /// Timer periódico (versão C#, orientada a eventos, do timer de timer_pic.c).
+    /// Em vez de decrementar um contador a cada ciclo, agenda seu próximo estouro
+    /// no <see cref="EventScheduler"/> do motor — custo zero entre estouros.
+    /// Como no modelo em C, a IRQ começa desabilitada: por padrão o timer apenas conta eventos.
+    /// </summary>
+    public class DispositivoTimer
+    {
+        private readonly EventScheduler _agenda;
+        private readonly IPicController _pic;
+        private EventoAgendado? _proximo;
+
+        public int PeriodoCiclos { get; private set; }
+        public int VetorIrq { get; }
+        public bool Habilitado { get; private set; }
+        public bool IrqHabilitada { get; set; }
+
+        // STATUS (bit 0 = estouro pendente) e métricas
+        public byte Status { get; set; }
+        public long EventosGerados { get; private set; }
+
+        public DispositivoTimer(EventScheduler agenda, IPicController pic, int periodoCiclos, int vetorIrq = 0)
+        {
+            _agenda = agenda ?? throw new ArgumentNullException(nameof(agenda));
+            _pic = pic ?? throw new ArgumentNullException(nameof(pic));
+            if (periodoCiclos <= 0) throw new ArgumentOutOfRangeException(nameof(periodoCiclos), "Período deve ser positivo.");
+            PeriodoCiclos = periodoCiclos;
+            VetorIrq = vetorIrq;
+        }
+
+        /// <summary>
+        /// Habilita o timer; o primeiro estouro ocorre em <paramref name="cicloAtual"/> + período.
+        /// </summary>
+        public void Iniciar(long cicloAtual)
+        {
+            Parar();
+            Habilitado = true;
+            _proximo = _agenda.Agendar(cicloAtual + PeriodoCiclos, Estouro, "timer");
+        }
+
+        public void Parar()
+        {
+            Habilitado = false;
+            _agenda.Cancelar(_proximo);
+            _proximo = null;
+        }
+
+        /// <summary>
+        /// Altera o período; se o timer estiver ativo, reagenda a partir de <paramref name="cicloAtual"/>.
+        /// </summary>
+        public void DefinirPeriodo(int periodoCiclos, long cicloAtual)
+        {
+            if (periodoCiclos <= 0) throw new ArgumentOutOfRangeException(nameof(periodoCiclos), "Período deve ser positivo.");
+            PeriodoCiclos = periodoCiclos;
+            if (Habilitado) Iniciar(cicloAtual);
+        }
+
+        /// <summary>
+        /// Grava período, registradores e o ciclo do próximo estouro num checkpoint.
+        /// </summary>
+        public void SalvarEstado(BinaryWriter w)
+        {
+            w.Write(PeriodoCiclos);
+            w.Write(Habilitado);
+            w.Write(IrqHabilitada);
+            w.Write(Status);
+            w.Write(EventosGerados);
+            w.Write(_proximo is { Cancelado: false } p ? p.Ciclo : -1L);
+        }
+
+        /// <summary>
+        /// Restaura o estado gravado por <see cref="SalvarEstado"/>, reagendando o próximo estouro
+        /// no mesmo ciclo absoluto em que estava.
+        /// </summary>
+        public void RestaurarEstado(BinaryReader r)
+        {
+            Parar();
+            PeriodoCiclos = Math.Max(1, r.ReadInt32());
+            bool habilitado = r.ReadBoolean();
+            IrqHabilitada = r.ReadBoolean();
+            Status = r.ReadByte();
+            EventosGerados = r.ReadInt64();
+            long proximo = r.ReadInt64();
+
+            Habilitado = habilitado;
+            if (habilitado && proximo >= 0) _proximo = _agenda.Agendar(proximo, Estouro, "timer");
+        }
+
+        private void Estouro(long ciclo)
+        {
+            EventosGerados++;
+            Status = 1;
+            if (IrqHabilitada) _pic.RaiseIrq(VetorIrq);
+
+            // recarga: próximo estouro um período depois
+            _proximo = _agenda.Agendar(ciclo + PeriodoCiclos, Estouro, "timer");
+        }
+    }
+}
@@ -0,0 +1,265 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Série temporal em buffer circular de capacidade fixa: amostras antigas são sobrescritas
+    /// e nada é alocado após a construção (exceto nas cópias pedidas pelos leitores).
+    /// </summary>
+    public sealed class SerieTemporal
+    {
+        readonly double[] valores;
+        readonly object sync = new();
+        int inicio;
+        int quantidade;
+
+        public SerieTemporal(string nome, string unidade, int capacidade)
+        {
+            if (capacidade <= 0) throw new ArgumentOutOfRangeException(nameof(capacidade));
+            Nome = nome;
+            Unidade = unidade;
+            valores = new double[capacidade];
+        }
+
+        public string Nome { get; }
+        public string Unidade { get; }
+        public int Capacidade => valores.Length;
+
+        public int Quantidade
+        {
+            get { lock (sync) return quantidade; }
+        }
+
+        /// <summary>
+        /// Amostra mais recente (NaN se vazia).
+        /// </summary>
+        public double Ultimo
+        {
+            get
+            {
+                lock (sync)
+                {
+                    return quantidade == 0 ? double.NaN : valores[(inicio + quantidade - 1) % valores.Length];
+                }
+            }
+        }
+
+        public void Adicionar(double valor)
+        {
+            lock (sync)
+            {
+                if (quantidade < valores.Length)
+                {
+                    valores[(inicio + quantidade) % valores.Length] = valor;
+                    quantidade++;
+                }
+                else
+                {
+                    valores[inicio] = valor;
+                    inicio = (inicio + 1) % valores.Length;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Cópia das amostras em ordem cronológica (mais antiga primeiro).
+        /// </summary>
+        public double[] Valores()
+        {
+            lock (sync)
+            {
+                var copia = new double[quantidade];
+                for (int i = 0; i < quantidade; i++) copia[i] = valores[(inicio + i) % valores.Length];
+                return copia;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Leitura pontual dos contadores acumulados do motor, usada pelo amostrador.
+    /// </summary>
+    public readonly record struct ContadoresMotor(
+        long Ciclos,
+        long Instrucoes,
+        long TicksExecucao,
+        ulong AcessosCache,
+        ulong HitsCache,
+        long BytesDma
+    );
+
+    /// <summary>
+    /// Amostrador periódico de desempenho do motor: a cada período lê os contadores acumulados,
+    /// calcula taxas sobre o intervalo e as grava em séries circulares. A UI apenas lê as séries
+    /// (nada é recalculado por renderização). Métricas do processo host (alocações e contenção
+    /// de locks) vêm do runtime; latências de IRQ são registradas pelo motor via
+    /// <see cref="RegistrarLatenciaIrq"/> e resumidas em percentis por intervalo.
+    /// </summary>
+    public sealed class AmostradorDesempenho : IDisposable
+    {
+        /// <summary>
+        /// Amostras mantidas por série (2 minutos no período padrão).
+        /// </summary>
+        public const int CapacidadePadrao = 240;
+
+        // latências retidas por intervalo; excedentes são descartados (percentis aproximados)
+        const int MaxLatenciasPorIntervalo = 4_096;
+
+        readonly Func<ContadoresMotor> lerContadores;
+        readonly Timer timer;
+        readonly object latenciaSync = new();
+        readonly long[] latencias = new long[MaxLatenciasPorIntervalo];
+        readonly long[] latenciasOrdenadas = new long[MaxLatenciasPorIntervalo];
+        int latenciasNoIntervalo;
+
+        ContadoresMotor anterior;
+        long ticksAnterior;
+        long alocadosAnterior;
+        long contencaoAnterior;
+        int amostrando;
+
+        public AmostradorDesempenho(Func<ContadoresMotor> lerContadores, TimeSpan? periodo = null, int capacidade = CapacidadePadrao)
+        {
+            this.lerContadores = lerContadores ?? throw new ArgumentNullException(nameof(lerContadores));
+            Periodo = periodo ?? TimeSpan.FromMilliseconds(500);
+
+            CiclosPorSegundo = new SerieTemporal("Ciclos simulados/s", "ciclos/s", capacidade);
+            NsPorCiclo = new SerieTemporal("Tempo de host por ciclo", "ns", capacidade);
+            InstrucoesPorSegundo = new SerieTemporal("Instruções/s", "instr/s", capacidade);
+            HitRateCache = new SerieTemporal("Hit rate da cache (intervalo)", "%", capacidade);
+            LatenciaIrqP50 = new SerieTemporal("Latência IRQ p50", "ciclos", capacidade);
+            LatenciaIrqP95 = new SerieTemporal("Latência IRQ p95", "ciclos", capacidade);
+            LatenciaIrqP99 = new SerieTemporal("Latência IRQ p99", "ciclos", capacidade);
+            DmaBytesPorSegundo = new SerieTemporal("Vazão DMA", "bytes/s", capacidade);
+            AlocacoesPorSegundo = new SerieTemporal("Alocações GC", "bytes/s", capacidade);
+            ContencaoPorSegundo = new SerieTemporal("Contenção de locks", "eventos/s", capacidade);
+            Series = new[]
+            {
+                CiclosPorSegundo, NsPorCiclo, InstrucoesPorSegundo, HitRateCache,
+                LatenciaIrqP50, LatenciaIrqP95, LatenciaIrqP99,
+                DmaBytesPorSegundo, AlocacoesPorSegundo, ContencaoPorSegundo
+            };
+
+            anterior = lerContadores();
+            ticksAnterior = Stopwatch.GetTimestamp();
+            alocadosAnterior = GC.GetTotalAllocatedBytes();
+            contencaoAnterior = Monitor.LockContentionCount;
+            timer = new Timer(_ => Amostrar(), null, Periodo, Periodo);
+        }
+
+        public TimeSpan Periodo { get; }
+
+        public SerieTemporal CiclosPorSegundo { get; }
+        public SerieTemporal NsPorCiclo { get; }
+        public SerieTemporal InstrucoesPorSegundo { get; }
+        public SerieTemporal HitRateCache { get; }
+        public SerieTemporal LatenciaIrqP50 { get; }
+        public SerieTemporal LatenciaIrqP95 { get; }
+        public SerieTemporal LatenciaIrqP99 { get; }
+        public SerieTemporal DmaBytesPorSegundo { get; }
+        public SerieTemporal AlocacoesPorSegundo { get; }
+        public SerieTemporal ContencaoPorSegundo { get; }
+
+        /// <summary>
+        /// Todas as séries, na ordem de exibição.
+        /// </summary>
+        public IReadOnlyList<SerieTemporal> Series { get; }
+
+        /// <summary>
+        /// Total de IRQs reconhecidas desde a criação.
+        /// </summary>
+        public long IrqsMedidas { get; private set; }
+
+        /// <summary>
+        /// Registra a latência (em ciclos) de uma IRQ atendida. Chamado pela thread do motor.
+        /// </summary>
+        public void RegistrarLatenciaIrq(long ciclos)
+        {
+            lock (latenciaSync)
+            {
+                IrqsMedidas++;
+                if (latenciasNoIntervalo < latencias.Length) latencias[latenciasNoIntervalo++] = ciclos;
+            }
+        }
+
+        void Amostrar()
+        {
+            // callbacks do timer podem se sobrepor se uma amostra atrasar
+            if (Interlocked.Exchange(ref amostrando, 1) == 1) return;
+            try
+            {
+                var atual = lerContadores();
+                long agora = Stopwatch.GetTimestamp();
+                long alocados = GC.GetTotalAllocatedBytes();
+                long contencao = Monitor.LockContentionCount;
+
+                double segundos = (double)(agora - ticksAnterior) / Stopwatch.Frequency;
+                if (segundos <= 0) return;
+
+                long ciclos = atual.Ciclos - anterior.Ciclos;
+                long ticksExec = atual.TicksExecucao - anterior.TicksExecucao;
+                ulong acessos = atual.AcessosCache - anterior.AcessosCache;
+                ulong hits = atual.HitsCache - anterior.HitsCache;
+
+                CiclosPorSegundo.Adicionar(ciclos / segundos);
+                NsPorCiclo.Adicionar(ciclos > 0 ? ticksExec * 1e9 / Stopwatch.Frequency / ciclos : 0);
+                InstrucoesPorSegundo.Adicionar((atual.Instrucoes - anterior.Instrucoes) / segundos);
+                // reconstruções da cache podem zerar contadores: intervalo sem acessos válidos -> NaN
+                HitRateCache.Adicionar(acessos > 0 && hits <= acessos ? 100.0 * hits / acessos : double.NaN);
+                DmaBytesPorSegundo.Adicionar(Math.Max(0, atual.BytesDma - anterior.BytesDma) / segundos);
+                AlocacoesPorSegundo.Adicionar((alocados - alocadosAnterior) / segundos);
+                ContencaoPorSegundo.Adicionar((contencao - contencaoAnterior) / segundos);
+                AmostrarLatencias();
+
+                anterior = atual;
+                ticksAnterior = agora;
+                alocadosAnterior = alocados;
+                contencaoAnterior = contencao;
+            }
+            catch
+            {
+                // amostragem nunca derruba o processo
+            }
+            finally
+            {
+                Volatile.Write(ref amostrando, 0);
+            }
+        }
+
+        void AmostrarLatencias()
+        {
+            int n;
+            lock (latenciaSync)
+            {
+                n = latenciasNoIntervalo;
+                Array.Copy(latencias, latenciasOrdenadas, n);
+                latenciasNoIntervalo = 0;
+            }
+
+            if (n == 0)
+            {
+                LatenciaIrqP50.Adicionar(double.NaN);
+                LatenciaIrqP95.Adicionar(double.NaN);
+                LatenciaIrqP99.Adicionar(double.NaN);
+                return;
+            }
+
+            var ordenadas = latenciasOrdenadas.AsSpan(0, n);
+            ordenadas.Sort();
+            LatenciaIrqP50.Adicionar(Percentil(ordenadas, 0.50));
+            LatenciaIrqP95.Adicionar(Percentil(ordenadas, 0.95));
+            LatenciaIrqP99.Adicionar(Percentil(ordenadas, 0.99));
+        }
+
+        // nearest-rank
+        static double Percentil(ReadOnlySpan<long> ordenadas, double p)
+        {
+            int indice = (int)Math.Ceiling(p * ordenadas.Length) - 1;
+            return ordenadas[Math.Clamp(indice, 0, ordenadas.Length - 1)];
+        }
+
+        public void Dispose() => timer.Dispose();
+    }
+}
@@ -0,0 +1,188 @@
+using System;
+using System.Diagnostics;
+using System.Threading;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Marcapasso de relógio: faz a simulação acompanhar o tempo real na frequência alvo
+    /// (<see cref="Configuracoes.ClockHz"/>). O motor executa lotes do tamanho devolvido por
+    /// <see cref="ProximoLote"/> e, quando adiantado, chama <see cref="Aguardar"/>
+    /// (dorme para esperas longas, gira para o último trecho).
+    /// Se o host não acompanha, o atraso acumulado acima de <c>atrasoMaximo</c> é descartado
+    /// (não há rajada de recuperação) e o fator de lentidão é reportado em <see cref="ObterStatus"/>.
+    /// Não é thread-safe: pertence à thread de simulação.
+    /// </summary>
+    public sealed class ClockPacer
+    {
+        // abaixo deste tempo de espera não vale dormir (granularidade do Sleep ~1 ms)
+        const double LimiarSpinMs = 1.5;
+
+        readonly Stopwatch relogio = new();
+        readonly long loteMaximo;
+        readonly long ticksAtrasoMaximo;
+
+        double hz;
+
+        // origem do cronograma atual (reiniciada ao descartar atraso ou trocar a frequência)
+        long ticksBase;
+        long ciclosBase;
+
+        long executados;
+
+        // janela para a razão recente
+        long ticksUltimoStatus;
+        long ciclosUltimoStatus;
+
+        public ClockPacer(double clockHz, long loteMaximo = 4_096, TimeSpan? atrasoMaximo = null)
+        {
+            if (clockHz <= 0) throw new ArgumentOutOfRangeException(nameof(clockHz), "Frequência deve ser positiva.");
+            if (loteMaximo <= 0) throw new ArgumentOutOfRangeException(nameof(loteMaximo));
+
+            hz = clockHz;
+            this.loteMaximo = loteMaximo;
+            ticksAtrasoMaximo = (long)((atrasoMaximo ?? TimeSpan.FromMilliseconds(50)).TotalSeconds * Stopwatch.Frequency);
+        }
+
+        public double ClockHz => hz;
+
+        /// <summary>
+        /// Ciclos de atraso descartados porque o host não acompanhou a frequência alvo.
+        /// </summary>
+        public long CiclosDescartados { get; private set; }
+
+        public void Iniciar()
+        {
+            relogio.Restart();
+            ticksBase = ciclosBase = executados = 0;
+            ticksUltimoStatus = ciclosUltimoStatus = 0;
+            CiclosDescartados = 0;
+        }
+
+        /// <summary>
+        /// Altera a frequência alvo sem perder as estatísticas acumuladas.
+        /// </summary>
+        public void DefinirFrequencia(double clockHz)
+        {
+            if (clockHz <= 0) throw new ArgumentOutOfRangeException(nameof(clockHz), "Frequência deve ser positiva.");
+            if (clockHz == hz) return;
+            hz = clockHz;
+            Rebase(relogio.ElapsedTicks);
+        }
+
+        /// <summary>
+        /// Quantidade de ciclos a executar agora (0 quando adiantado em relação ao relógio).
+        /// </summary>
+        public long ProximoLote()
+        {
+            long agora = relogio.ElapsedTicks;
+            long devidos = CiclosAte(agora) - (executados - ciclosBase);
+
+            // atrasado além do limite: descarta o excedente em vez de tentar recuperar em rajada
+            long limiteAtraso = CiclosEm(ticksAtrasoMaximo);
+            if (devidos > limiteAtraso + loteMaximo)
+            {
+                CiclosDescartados += devidos - loteMaximo;
+                Rebase(agora - TicksPara(loteMaximo));
+                devidos = loteMaximo;
+            }
+
+            return Math.Clamp(devidos, 0, loteMaximo);
+        }
+
+        /// <summary>
+        /// Registra ciclos efetivamente executados.
+        /// </summary>
+        public void Registrar(long ciclos) => executados += ciclos;
+
+        /// <summary>
+        /// Espera até o próximo ciclo devido: dorme em <paramref name="cancelamento"/> (se houver)
+        /// para esperas longas e gira no trecho final para precisão sub-milissegundo.
+        /// </summary>
+        public void Aguardar(ManualResetEventSlim? cancelamento = null)
+        {
+            long alvo = ticksBase + TicksPara(executados - ciclosBase + 1);
+            long restante = alvo - relogio.ElapsedTicks;
+            if (restante <= 0) return;
+
+            double ms = restante * 1000.0 / Stopwatch.Frequency;
+            if (ms > LimiarSpinMs)
+            {
+                int dormir = (int)(ms - 1);
+                if (cancelamento is not null)
+                {
+                    if (cancelamento.Wait(dormir)) return;
+                }
+                else Thread.Sleep(dormir);
+            }
+
+            var spinner = new SpinWait();
+            while (relogio.ElapsedTicks < alvo)
+            {
+                if (cancelamento is { IsSet: true }) return;
+                spinner.SpinOnce(sleep1Threshold: -1);
+            }
+        }
+
+        /// <summary>
+        /// Estatísticas de ritmo: frequência atingida, razão sobre o alvo (total e desde a
+        /// última consulta), deriva em relação ao cronograma e fator de lentidão.
+        /// </summary>
+        public PacingStatus ObterStatus()
+        {
+            long agora = relogio.ElapsedTicks;
+            double segundos = (double)agora / Stopwatch.Frequency;
+            double atingidos = segundos > 0 ? executados / segundos : 0;
+            double razao = atingidos / hz;
+
+            double segundosJanela = (double)(agora - ticksUltimoStatus) / Stopwatch.Frequency;
+            double razaoRecente = segundosJanela > 0 ? (executados - ciclosUltimoStatus) / segundosJanela / hz : razao;
+            ticksUltimoStatus = agora;
+            ciclosUltimoStatus = executados;
+
+            // deriva: positivo = simulação adiantada em relação ao relógio, negativo = atrasada
+            long ticksDevidos = ticksBase + TicksPara(executados - ciclosBase);
+            double derivaMs = (ticksDevidos - agora) * 1000.0 / Stopwatch.Frequency;
+
+            bool naoAcompanha = CiclosDescartados > 0 && razaoRecente < 0.95;
+            double fatorLentidao = razaoRecente > 0 ? Math.Max(1.0, 1.0 / razaoRecente) : 0;
+
+            return new PacingStatus(
+                ClockHzAlvo: hz,
+                CiclosPorSegundoAtingidos: atingidos,
+                RazaoAtingida: razao,
+                RazaoRecente: razaoRecente,
+                DerivaMs: derivaMs,
+                FatorLentidao: fatorLentidao,
+                HostNaoAcompanha: naoAcompanha,
+                CiclosDescartados: CiclosDescartados
+            );
+        }
+
+        void Rebase(long ticks)
+        {
+            ticksBase = ticks;
+            ciclosBase = executados;
+        }
+
+        long CiclosAte(long ticks) => CiclosEm(ticks - ticksBase);
+
+        long CiclosEm(long ticks) => (long)(ticks * hz / Stopwatch.Frequency);
+
+        long TicksPara(long ciclos) => (long)(ciclos * (double)Stopwatch.Frequency / hz);
+    }
+
+    /// <summary>
+    /// Estado do modo relógio, exposto para UI/API.
+    /// </summary>
+    public record PacingStatus(
+        double ClockHzAlvo,
+        double CiclosPorSegundoAtingidos,
+        double RazaoAtingida,
+        double RazaoRecente,
+        double DerivaMs,
+        double FatorLentidao,
+        bool HostNaoAcompanha,
+        long CiclosDescartados
+    );
+}
@@ -7,7 +7,7 @@ namespace ProjetoSimuladorPC.Utilidades
     /// Modelo de configurações usado por Counter.razor e por SimulationState.Config.
     /// Propriedades possuem valores padrão compatíveis com o formulário.
     /// </summary>
-    public class Configuracoes
+    public class Configuracoes : IValidatableObject
     {
         // Geral
         [Required]
@@ -75,6 +75,14 @@ namespace ProjetoSimuladorPC.Utilidades
         [Range(1, 1024)]
         public int DmaBurstLen { get; set; } = 16;
 
+        // Execução
+
+        /// <summary>
+        /// Modo determinístico: todos os dispositivos avançam pelo contador de ciclos do motor
+        /// (DMA inclusive), de modo que a mesma configuração e carga produzem contadores idênticos.
+        /// </summary>
+        public bool Deterministico { get; set; }
+
         // Utilitários
 
         /// <summary>
@@ -93,5 +101,14 @@ namespace ProjetoSimuladorPC.Utilidades
             var ctx = new ValidationContext(this);
             Validator.ValidateObject(this, ctx, validateAllProperties: true);
         }
+
+        /// <summary>
+        /// Regras que não cabem em atributos: L1Size precisa ser um tamanho reconhecido.
+        /// </summary>
+        public IEnumerable<ValidationResult> Validate(ValidationContext validationContext)
+        {
+            if (SimulationEngine.ParseMemorySize(L1Size) is not > 0)
+                yield return new ValidationResult($"L1Size inválido: '{L1Size}' (use ex. 16KB, 1MB ou bytes).", new[] { nameof(L1Size) });
+        }
     }
 }
\ No newline at end of file
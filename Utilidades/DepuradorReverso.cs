@@ -0,0 +1,395 @@
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+using ProjetoSimuladorPC.RAM;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Entrada externa (não determinística) registrada no histórico, aplicada no ciclo indicado.
+    /// </summary>
+    public abstract record EntradaExterna(long Ciclo);
+
+    /// <summary>Escrita na RAM feita pela UI/API.</summary>
+    public sealed record EscritaRamExterna(long Ciclo, int Endereco, byte[] Dados) : EntradaExterna(Ciclo);
+
+    /// <summary>Transferência DMA iniciada pela UI/API.</summary>
+    public sealed record DmaExterna(long Ciclo, int Origem, int Destino, int Tamanho) : EntradaExterna(Ciclo);
+
+    /// <summary>Reconfiguração aplicada pela UI/API.</summary>
+    public sealed record ConfiguracaoExterna(long Ciclo, Configuracoes Config, bool MigrarCache) : EntradaExterna(Ciclo);
+
+    /// <summary>
+    /// Parâmetros da depuração reversa.
+    /// </summary>
+    public class OpcoesDepuracaoReversa
+    {
+        /// <summary>Ciclos entre pontos de retorno (custo de um passo atrás ≈ reexecutar até isto).</summary>
+        public long IntervaloCiclos { get; set; } = 100_000;
+
+        /// <summary>Pontos retidos; o mais antigo é descartado ao exceder.</summary>
+        public int MaxPontos { get; set; } = 64;
+    }
+
+    public record StatusDepuracaoReversa(
+        long IntervaloCiclos,
+        int Pontos,
+        long CicloMaisAntigo,
+        long CicloAtual,
+        int Entradas,
+        long BytesRetidos
+    );
+
+    /// <summary>
+    /// Depuração reversa por pontos de retorno periódicos e reexecução. A cada
+    /// <see cref="OpcoesDepuracaoReversa.IntervaloCiclos"/> ciclos guarda o estado dos dispositivos
+    /// e uma tabela de páginas de RAM (4 KiB) copiada sob demanda: só as páginas escritas desde o
+    /// ponto anterior são copiadas; as demais são compartilhadas com ele. Entradas externas
+    /// (escritas da UI, DMA, reconfigurações) são registradas com o ciclo em que ocorreram e
+    /// reaplicadas na reexecução, que é determinística a partir de um ponto.
+    /// Voltar no tempo = restaurar o ponto mais próximo antes do alvo e reexecutar até ele.
+    /// Todos os membros internos executam sob o lock de execução do motor.
+    /// </summary>
+    public sealed class DepuradorReverso
+    {
+        sealed class PontoRetorno
+        {
+            public required long Ciclo { get; init; }
+            public required byte[] Dispositivos { get; init; }
+            public required Configuracoes Config { get; init; }
+            public required byte[][] Paginas { get; init; }
+
+            // páginas escritas entre este ponto e o seguinte (null para o último)
+            public ulong[]? AlteradasDepois { get; set; }
+
+            // bytes de páginas que só este ponto referencia (dentre os retidos)
+            public long BytesProprios { get; set; }
+        }
+
+        const int TamanhoPagina = 1 << Ram.BitsPaginaRastreada;
+
+        // página nula compartilhada por todos os pontos
+        static readonly byte[] PaginaZerada = new byte[TamanhoPagina];
+
+        readonly SimulationEngine engine;
+        readonly List<PontoRetorno> pontos = new();
+        readonly List<EntradaExterna> entradas = new();
+        int cursor;       // próxima entrada a aplicar
+        int indiceBase;   // ponto a partir do qual a RAM atual é rastreada
+        long proximoPonto;
+
+        internal DepuradorReverso(SimulationEngine engine, OpcoesDepuracaoReversa opcoes)
+        {
+            if (opcoes.IntervaloCiclos <= 0) throw new ArgumentOutOfRangeException(nameof(opcoes), "IntervaloCiclos deve ser positivo.");
+            if (opcoes.MaxPontos < 2) throw new ArgumentOutOfRangeException(nameof(opcoes), "MaxPontos deve ser ao menos 2.");
+            this.engine = engine;
+            Opcoes = opcoes;
+        }
+
+        public OpcoesDepuracaoReversa Opcoes { get; }
+
+        SimulationState Estado => engine.Estado;
+
+        public StatusDepuracaoReversa ObterStatus()
+        {
+            lock (engine.Sincronizacao)
+            {
+                long bytes = 0;
+                foreach (var p in pontos) bytes += p.BytesProprios + p.Dispositivos.Length;
+                return new StatusDepuracaoReversa(Opcoes.IntervaloCiclos, pontos.Count,
+                    pontos.Count > 0 ? pontos[0].Ciclo : Estado.CicloAtual, Estado.CicloAtual, entradas.Count, bytes);
+            }
+        }
+
+        /// <summary>
+        /// Volta <paramref name="ciclos"/> ciclos. Retorna o ciclo atingido.
+        /// </summary>
+        public long VoltarCiclos(long ciclos)
+        {
+            if (ciclos < 0) throw new ArgumentOutOfRangeException(nameof(ciclos));
+            return engine.Navegar(() => IrParaInterno(Estado.CicloAtual - ciclos));
+        }
+
+        /// <summary>
+        /// Leva a máquina ao ciclo <paramref name="ciclo"/> (para trás ou para frente). Lança
+        /// <see cref="ArgumentOutOfRangeException"/> se o ciclo for anterior ao histórico retido.
+        /// Para frente, executa em fatias e para ao cancelar <paramref name="ct"/>: retorna o
+        /// ciclo atingido, ou null se o alvo não foi alcançado (a máquina fica onde parou).
+        /// </summary>
+        public long? IrPara(long ciclo, CancellationToken ct = default) => engine.Navegar(() =>
+        {
+            long atingido = IrParaInterno(ciclo, ct);
+            return atingido == ciclo ? atingido : (long?)null;
+        });
+
+        /// <summary>
+        /// Volta até o último ciclo, antes do atual, em que <paramref name="condicao"/> era verdadeira
+        /// (ex.: breakpoint em um PC). Retorna o ciclo encontrado, ou null (a máquina fica onde estava).
+        /// </summary>
+        public long? VoltarAte(Func<SimulationState, bool> condicao)
+        {
+            if (condicao is null) throw new ArgumentNullException(nameof(condicao));
+            return engine.Navegar(() => VoltarAteInterno(condicao));
+        }
+
+        /// <summary>
+        /// Breakpoint reverso no contador de programa.
+        /// </summary>
+        public long? VoltarAtePc(int endereco) => VoltarAte(s => s.Cpu.ContadorPrograma == endereco);
+
+        // fatia da execução para frente entre verificações de cancelamento
+        const long FatiaAvanco = 65_536;
+
+        long IrParaInterno(long alvo, CancellationToken ct = default)
+        {
+            if (alvo < pontos[0].Ciclo)
+                throw new ArgumentOutOfRangeException(nameof(alvo), $"O histórico retido começa no ciclo {pontos[0].Ciclo}.");
+
+            long atual = Estado.CicloAtual;
+            int i = UltimoPontoAte(alvo);
+            // para frente sem ponto intermediário, basta continuar executando
+            if (alvo < atual || pontos[i].Ciclo > atual) Restaurar(i);
+
+            while (Estado.CicloAtual < alvo && !ct.IsCancellationRequested)
+                engine.ExecutarSobBloqueio(Math.Min(alvo - Estado.CicloAtual, FatiaAvanco), null);
+            return Estado.CicloAtual;
+        }
+
+        long? VoltarAteInterno(Func<SimulationState, bool> condicao)
+        {
+            long fim = Estado.CicloAtual;
+
+            // do trecho mais recente para o mais antigo; em cada um, a última ocorrência antes de fim
+            for (int i = UltimoPontoAte(fim); i >= 0; i--)
+            {
+                if (pontos[i].Ciclo >= fim) continue;
+                Restaurar(i);
+                long limite = i + 1 < pontos.Count ? Math.Min(pontos[i + 1].Ciclo, fim) : fim;
+
+                long? ultimo = condicao(Estado) ? Estado.CicloAtual : null;
+                while (Estado.CicloAtual < limite)
+                {
+                    long pedido = limite - Estado.CicloAtual;
+                    long feitos = engine.ExecutarSobBloqueio(pedido, condicao);
+                    if ((feitos < pedido || condicao(Estado)) && Estado.CicloAtual < fim) ultimo = Estado.CicloAtual;
+                }
+
+                if (ultimo is long encontrado) return IrParaInterno(encontrado);
+            }
+
+            IrParaInterno(fim);
+            return null;
+        }
+
+        /// <summary>
+        /// Descarta o histórico e recomeça com um ponto completo no ciclo atual.
+        /// </summary>
+        internal void Reiniciar()
+        {
+            pontos.Clear();
+            entradas.Clear();
+            cursor = 0;
+            engine.Ram.RastrearAlteracoes(true);
+            pontos.Add(NovoPonto(null, null));
+            indiceBase = 0;
+            proximoPonto = Estado.CicloAtual + Opcoes.IntervaloCiclos;
+        }
+
+        internal void Desligar()
+        {
+            engine.Ram.RastrearAlteracoes(false);
+            pontos.Clear();
+            entradas.Clear();
+        }
+
+        /// <summary>
+        /// Registra uma entrada externa já aplicada no ciclo atual. Se a máquina estiver no
+        /// passado, o futuro registrado (entradas e pontos) deixa de valer: nova linha do tempo.
+        /// </summary>
+        internal void Registrar(EntradaExterna entrada)
+        {
+            if (cursor < entradas.Count) entradas.RemoveRange(cursor, entradas.Count - cursor);
+            DescartarFuturo();
+            entradas.Add(entrada);
+            cursor = entradas.Count;
+        }
+
+        /// <summary>
+        /// Executa ciclos parando nas fronteiras de ponto (para capturá-los) e nos ciclos das
+        /// entradas registradas à frente (para reaplicá-las). Chamado por ExecutarCiclos do motor.
+        /// </summary>
+        internal long Executar(long quantidade, Func<SimulationState, bool>? parada)
+        {
+            long feitos = 0;
+            while (feitos < quantidade)
+            {
+                long ciclo = Estado.CicloAtual;
+                while (cursor < entradas.Count && entradas[cursor].Ciclo <= ciclo) engine.AplicarEntrada(entradas[cursor++]);
+
+                long limite = Math.Min(quantidade - feitos, proximoPonto - ciclo);
+                if (cursor < entradas.Count) limite = Math.Min(limite, entradas[cursor].Ciclo - ciclo);
+
+                long n = engine.ExecutarCiclosNucleo(limite, parada);
+                feitos += n;
+                if (Estado.CicloAtual >= proximoPonto) Capturar();
+
+                // a condição pode ter sido atingida exatamente no último ciclo do trecho
+                if (n < limite || (parada is not null && parada(Estado))) break;
+            }
+            return feitos;
+        }
+
+        void Capturar()
+        {
+            long ciclo = Estado.CicloAtual;
+            var alteradas = engine.Ram.ColetarAlteradas();
+
+            if (indiceBase + 1 < pontos.Count && pontos[indiceBase + 1].Ciclo == ciclo)
+            {
+                // reexecução de um trecho já registrado: o ponto seguinte já existe e é idêntico
+                indiceBase++;
+            }
+            else
+            {
+                DescartarFuturo();
+                var anterior = pontos[indiceBase];
+                pontos.Add(NovoPonto(anterior, alteradas));
+                anterior.AlteradasDepois = alteradas;
+                indiceBase = pontos.Count - 1;
+
+                while (pontos.Count > Opcoes.MaxPontos) DescartarMaisAntigo();
+            }
+            proximoPonto = ciclo + Opcoes.IntervaloCiclos;
+        }
+
+        // copia as páginas alteradas (todas, se não houver ponto anterior) e compartilha o resto
+        PontoRetorno NovoPonto(PontoRetorno? anterior, ulong[]? alteradas)
+        {
+            byte[][] paginas = anterior is null ? new byte[engine.Ram.PaginasRastreadas][] : (byte[][])anterior.Paginas.Clone();
+            long copiados = 0;
+
+            engine.Ram.ComMemoria(memoria =>
+            {
+                if (anterior is null || alteradas is null)
+                {
+                    for (int p = 0; p < paginas.Length; p++) paginas[p] = CopiarPagina(memoria, p, ref copiados);
+                    return;
+                }
+                for (int w = 0; w < alteradas.Length; w++)
+                {
+                    for (ulong bits = alteradas[w]; bits != 0; bits &= bits - 1)
+                    {
+                        int p = w * 64 + BitOperations.TrailingZeroCount(bits);
+                        paginas[p] = CopiarPagina(memoria, p, ref copiados);
+                    }
+                }
+            });
+
+            return new PontoRetorno
+            {
+                Ciclo = Estado.CicloAtual,
+                Dispositivos = engine.CapturarDispositivos(),
+                Config = engine.ConfigAtiva.Clone(),
+                Paginas = paginas,
+                BytesProprios = copiados
+            };
+        }
+
+        static byte[] CopiarPagina(byte[] memoria, int pagina, ref long copiados)
+        {
+            int inicio = pagina * TamanhoPagina;
+            var origem = memoria.AsSpan(inicio, Math.Min(TamanhoPagina, memoria.Length - inicio));
+            if (origem.IndexOfAnyExcept((byte)0) < 0 && origem.Length == TamanhoPagina) return PaginaZerada;
+
+            copiados += origem.Length;
+            return origem.ToArray();
+        }
+
+        void Restaurar(int indice)
+        {
+            var alvo = pontos[indice];
+
+            // páginas que podem diferir do alvo: as escritas desde a base e as dos trechos entre base e alvo
+            var repor = engine.Ram.ColetarAlteradas() ?? new ulong[(alvo.Paginas.Length + 63) / 64];
+            for (int i = Math.Min(indice, indiceBase); i < Math.Max(indice, indiceBase); i++)
+            {
+                var trecho = pontos[i].AlteradasDepois;
+                for (int w = 0; w < repor.Length; w++) repor[w] |= trecho is null ? ulong.MaxValue : trecho[w];
+            }
+
+            engine.Ram.ComMemoria(memoria =>
+            {
+                for (int w = 0; w < repor.Length; w++)
+                {
+                    for (ulong bits = repor[w]; bits != 0; bits &= bits - 1)
+                    {
+                        int p = w * 64 + BitOperations.TrailingZeroCount(bits);
+                        if (p >= alvo.Paginas.Length) break;
+                        var pagina = alvo.Paginas[p];
+                        int inicio = p * TamanhoPagina;
+                        pagina.AsSpan(0, Math.Min(pagina.Length, memoria.Length - inicio)).CopyTo(memoria.AsSpan(inicio));
+                    }
+                }
+            });
+
+            engine.RestaurarDispositivos(alvo.Dispositivos, alvo.Config, alvo.Ciclo);
+            indiceBase = indice;
+            proximoPonto = alvo.Ciclo + Opcoes.IntervaloCiclos;
+            cursor = PrimeiraEntradaDesde(alvo.Ciclo);
+        }
+
+        // pontos posteriores à base deixam de valer quando a linha do tempo muda
+        void DescartarFuturo()
+        {
+            if (indiceBase + 1 >= pontos.Count) return;
+            pontos.RemoveRange(indiceBase + 1, pontos.Count - indiceBase - 1);
+            pontos[indiceBase].AlteradasDepois = null;
+        }
+
+        void DescartarMaisAntigo()
+        {
+            var antigo = pontos[0];
+            var seguinte = pontos[1];
+
+            // páginas herdadas do ponto descartado passam a ser do seguinte
+            for (int p = 0; p < seguinte.Paginas.Length; p++)
+            {
+                var pagina = seguinte.Paginas[p];
+                if (ReferenceEquals(pagina, antigo.Paginas[p]) && !ReferenceEquals(pagina, PaginaZerada))
+                    seguinte.BytesProprios += pagina.Length;
+            }
+
+            pontos.RemoveAt(0);
+            indiceBase--;
+
+            // entradas anteriores ao ponto mais antigo não podem mais ser reexecutadas
+            int obsoletas = PrimeiraEntradaDesde(seguinte.Ciclo);
+            entradas.RemoveRange(0, obsoletas);
+            cursor -= obsoletas;
+        }
+
+        int UltimoPontoAte(long ciclo)
+        {
+            int lo = 0, hi = pontos.Count - 1;
+            while (lo < hi)
+            {
+                int meio = (lo + hi + 1) / 2;
+                if (pontos[meio].Ciclo <= ciclo) lo = meio;
+                else hi = meio - 1;
+            }
+            return lo;
+        }
+
+        int PrimeiraEntradaDesde(long ciclo)
+        {
+            int lo = 0, hi = entradas.Count;
+            while (lo < hi)
+            {
+                int meio = (lo + hi) / 2;
+                if (entradas[meio].Ciclo < ciclo) lo = meio + 1;
+                else hi = meio;
+            }
+            return lo;
+        }
+    }
+}
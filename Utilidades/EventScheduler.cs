@@ -0,0 +1,129 @@
+using System;
+using System.Collections.Generic;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Evento agendado na fila do motor. Mantido como referência para permitir cancelamento.
+    /// </summary>
+    public sealed class EventoAgendado
+    {
+        internal EventoAgendado(long ciclo, long sequencia, Action<long> callback, string? nome)
+        {
+            Ciclo = ciclo;
+            Sequencia = sequencia;
+            Callback = callback;
+            Nome = nome ?? string.Empty;
+        }
+
+        public long Ciclo { get; }
+        public string Nome { get; }
+        public bool Cancelado { get; internal set; }
+
+        internal long Sequencia { get; }
+        internal Action<long> Callback { get; }
+    }
+
+    /// <summary>
+    /// Fila central de eventos discretos, indexada pelo ciclo absoluto da simulação.
+    /// Dispositivos agendam callbacks para ciclos futuros; o motor executa a CPU em quanta
+    /// até o próximo evento e então dispara os eventos vencidos.
+    /// Eventos no mesmo ciclo disparam na ordem em que foram agendados (determinístico).
+    /// Não é thread-safe: use apenas a partir da thread que executa o motor.
+    /// </summary>
+    public sealed class EventScheduler
+    {
+        readonly PriorityQueue<EventoAgendado, (long Ciclo, long Sequencia)> fila = new();
+        long proximaSequencia;
+        long proximoCiclo = long.MaxValue;
+        int ativos;
+
+        /// <summary>
+        /// Ciclo do próximo evento pendente, ou <see cref="long.MaxValue"/> se a fila estiver vazia.
+        /// Leitura barata (campo) — pode ser consultada a cada ciclo pelo laço da CPU.
+        /// </summary>
+        public long ProximoCiclo => proximoCiclo;
+
+        /// <summary>
+        /// Quantidade de eventos pendentes (não cancelados).
+        /// </summary>
+        public int Pendentes => ativos;
+
+        /// <summary>
+        /// Total de eventos disparados desde a criação.
+        /// </summary>
+        public long EventosDisparados { get; private set; }
+
+        /// <summary>
+        /// Agenda <paramref name="callback"/> para o ciclo absoluto <paramref name="ciclo"/>.
+        /// O callback recebe o ciclo em que foi agendado e pode agendar novos eventos.
+        /// </summary>
+        public EventoAgendado Agendar(long ciclo, Action<long> callback, string? nome = null)
+        {
+            if (callback is null) throw new ArgumentNullException(nameof(callback));
+            if (ciclo < 0) throw new ArgumentOutOfRangeException(nameof(ciclo), "Ciclo não pode ser negativo.");
+
+            var evento = new EventoAgendado(ciclo, proximaSequencia++, callback, nome);
+            fila.Enqueue(evento, (ciclo, evento.Sequencia));
+            ativos++;
+            if (ciclo < proximoCiclo) proximoCiclo = ciclo;
+            return evento;
+        }
+
+        /// <summary>
+        /// Cancela um evento pendente. A remoção da fila é preguiçosa (ocorre ao alcançar o topo).
+        /// </summary>
+        public bool Cancelar(EventoAgendado? evento)
+        {
+            if (evento is null || evento.Cancelado) return false;
+            evento.Cancelado = true;
+            ativos--;
+            DescartarCancelados();
+            return true;
+        }
+
+        /// <summary>
+        /// Dispara, em ordem, todos os eventos com ciclo &lt;= <paramref name="cicloAtual"/>.
+        /// Eventos agendados pelos próprios callbacks para ciclos já vencidos também disparam.
+        /// Retorna a quantidade de eventos disparados.
+        /// </summary>
+        public int ExecutarVencidos(long cicloAtual)
+        {
+            int disparados = 0;
+            while (proximoCiclo <= cicloAtual)
+            {
+                var evento = fila.Dequeue();
+                ativos--;
+                // marca como consumido para que Cancelar posterior seja inofensivo
+                evento.Cancelado = true;
+                DescartarCancelados();
+
+                evento.Callback(evento.Ciclo);
+                disparados++;
+            }
+
+            EventosDisparados += disparados;
+            return disparados;
+        }
+
+        /// <summary>
+        /// Remove todos os eventos pendentes.
+        /// </summary>
+        public void Limpar()
+        {
+            while (fila.TryDequeue(out var evento, out _)) evento.Cancelado = true;
+            ativos = 0;
+            proximoCiclo = long.MaxValue;
+        }
+
+        // Mantém a invariante: o topo da fila nunca é um evento cancelado.
+        void DescartarCancelados()
+        {
+            while (fila.TryPeek(out var topo, out _) && topo.Cancelado)
+            {
+                fila.Dequeue();
+            }
+            proximoCiclo = fila.TryPeek(out _, out var prioridade) ? prioridade.Ciclo : long.MaxValue;
+        }
+    }
+}
@@ -0,0 +1,541 @@
+using System;
+using System.Buffers;
+using System.Buffers.Binary;
+using System.IO;
+using System.IO.Compression;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Seções de um checkpoint. O valor é a tag de 4 bytes ASCII gravada no arquivo.
+    /// </summary>
+    public enum SecaoCheckpoint : uint
+    {
+        Configuracao = 0x464E4F43, // "CONF"
+        Cpu = 0x20555043,          // "CPU "
+        Metricas = 0x5254454D,     // "METR"
+        Cache = 0x48434143,        // "CACH"
+        Pic = 0x20434950,          // "PIC "
+        Timer = 0x524D4954,        // "TIMR"
+        Dma = 0x20414D44,          // "DMA "
+        DmaAgenda = 0x47414D44,    // "DMAG"
+        Ram = 0x204D4152,          // "RAM "
+        Fim = 0x204D4946           // "FIM "
+    }
+
+    /// <summary>
+    /// Resumo de um checkpoint gravado ou restaurado.
+    /// </summary>
+    public record InfoCheckpoint(
+        int Versao,
+        long Ciclo,
+        DateTime CriadoEmUtc,
+        int PaginasRam,
+        int PaginasGravadas,
+        long BytesRam
+    );
+
+    /// <summary>
+    /// Formato binário versionado de checkpoint da máquina (little-endian):
+    /// <code>
+    /// cabeçalho: "SIMPCKPT" | u16 versão | u16 reservado | i64 ciclo | i64 ticks UTC
+    /// seções:    u32 tag | i64 comprimento | conteúdo      (repetidas; "FIM " encerra)
+    /// RAM:       comprimento = -1 (transmitida): i32 bytes | i32 página |
+    ///            registros i32 índice | u8 codificação | i32 comprimento | dados ... | i32 -1
+    /// </code>
+    /// Seções com tag desconhecida são ignoradas na leitura (compatibilidade adiante).
+    /// Só páginas não nulas são gravadas; cada uma vai comprimida com Brotli rápido
+    /// (ou bruta, se não encolher). A compressão é paralela por grupo de páginas e sobreposta à
+    /// escrita do grupo anterior, para que a gravação fique limitada pelo disco, não pela CPU.
+    /// </summary>
+    public static class FormatoCheckpoint
+    {
+        public const int Versao = 1;
+        public const int TamanhoPagina = 64 * 1024;
+
+        internal static ReadOnlySpan<byte> Assinatura => "SIMPCKPT"u8;
+
+        internal const byte PaginaBruta = 0;
+        internal const byte PaginaBrotli = 1;
+
+        // páginas comprimidas por vez (4 MiB de RAM por grupo)
+        internal const int PaginasPorGrupo = 64;
+
+        // Brotli qualidade 1 / janela 22: centenas de MB/s por núcleo, boa razão para RAM típica
+        internal const int QualidadeBrotli = 1;
+        internal const int JanelaBrotli = 22;
+    }
+
+    /// <summary>
+    /// Grava um checkpoint sequencialmente num <see cref="Stream"/> (não precisa ser pesquisável).
+    /// </summary>
+    public sealed class EscritorCheckpoint : IDisposable
+    {
+        readonly Stream destino;
+        readonly BinaryWriter escritor;
+        readonly bool comprimir;
+        bool finalizado;
+
+        public EscritorCheckpoint(Stream destino, long ciclo, bool comprimir = true)
+        {
+            this.destino = destino ?? throw new ArgumentNullException(nameof(destino));
+            this.comprimir = comprimir;
+            escritor = new BinaryWriter(destino, Encoding.UTF8, leaveOpen: true);
+
+            CriadoEmUtc = DateTime.UtcNow;
+            Ciclo = ciclo;
+            escritor.Write(FormatoCheckpoint.Assinatura);
+            escritor.Write((ushort)FormatoCheckpoint.Versao);
+            escritor.Write((ushort)0);
+            escritor.Write(ciclo);
+            escritor.Write(CriadoEmUtc.Ticks);
+        }
+
+        public long Ciclo { get; }
+        public DateTime CriadoEmUtc { get; }
+        public int PaginasRam { get; private set; }
+        public int PaginasGravadas { get; private set; }
+        public long BytesRam { get; private set; }
+
+        /// <summary>
+        /// Grava uma seção pequena: o conteúdo é montado em memória para prefixar o comprimento.
+        /// </summary>
+        public void Secao(SecaoCheckpoint secao, Action<BinaryWriter> conteudo)
+        {
+            using var ms = new MemoryStream();
+            using (var w = new BinaryWriter(ms, Encoding.UTF8, leaveOpen: true)) conteudo(w);
+
+            escritor.Write((uint)secao);
+            escritor.Write(ms.Length);
+            escritor.Flush();
+            ms.Position = 0;
+            ms.CopyTo(destino);
+        }
+
+        /// <summary>
+        /// Grava a seção de RAM. O chamador garante que <paramref name="memoria"/> não muda durante a gravação.
+        /// </summary>
+        public void Ram(byte[] memoria)
+        {
+            escritor.Write((uint)SecaoCheckpoint.Ram);
+            escritor.Write(-1L);
+            escritor.Write(memoria.Length);
+            escritor.Write(FormatoCheckpoint.TamanhoPagina);
+            escritor.Flush();
+
+            int paginas = (int)(((long)memoria.Length + FormatoCheckpoint.TamanhoPagina - 1) / FormatoCheckpoint.TamanhoPagina);
+            PaginasRam = paginas;
+            BytesRam = memoria.Length;
+
+            // pipeline: comprime o grupo seguinte enquanto o atual é escrito
+            Task<GrupoPaginas>? pendente = Task.Run(() => GrupoPaginas.Preparar(memoria, 0, comprimir));
+            for (int g = 0; g < paginas; g += FormatoCheckpoint.PaginasPorGrupo)
+            {
+                var grupo = pendente!.GetAwaiter().GetResult();
+                int seguinte = g + FormatoCheckpoint.PaginasPorGrupo;
+                pendente = seguinte < paginas ? Task.Run(() => GrupoPaginas.Preparar(memoria, seguinte, comprimir)) : null;
+
+                try
+                {
+                    PaginasGravadas += grupo.Escrever(destino, memoria);
+                }
+                finally
+                {
+                    grupo.Devolver();
+                }
+            }
+
+            Span<byte> fim = stackalloc byte[4];
+            BinaryPrimitives.WriteInt32LittleEndian(fim, -1);
+            destino.Write(fim);
+        }
+
+        /// <summary>
+        /// Grava a marca de fim e descarrega o stream.
+        /// </summary>
+        public InfoCheckpoint Finalizar()
+        {
+            if (!finalizado)
+            {
+                escritor.Write((uint)SecaoCheckpoint.Fim);
+                escritor.Write(0L);
+                escritor.Flush();
+                destino.Flush();
+                finalizado = true;
+            }
+            return new InfoCheckpoint(FormatoCheckpoint.Versao, Ciclo, CriadoEmUtc, PaginasRam, PaginasGravadas, BytesRam);
+        }
+
+        public void Dispose() => escritor.Dispose();
+
+        // páginas de um grupo já classificadas (nula / bruta / comprimida em buffer alugado)
+        sealed class GrupoPaginas
+        {
+            readonly int primeira;
+            readonly int quantidade;
+            readonly byte[]?[] comprimidas;
+            readonly int[] comprimentos;
+            readonly byte[] codificacoes;
+
+            const byte Nula = 0xFF;
+
+            GrupoPaginas(int primeira, int quantidade)
+            {
+                this.primeira = primeira;
+                this.quantidade = quantidade;
+                comprimidas = new byte[]?[quantidade];
+                comprimentos = new int[quantidade];
+                codificacoes = new byte[quantidade];
+            }
+
+            public static GrupoPaginas Preparar(byte[] memoria, int primeira, bool comprimir)
+            {
+                int total = (int)(((long)memoria.Length + FormatoCheckpoint.TamanhoPagina - 1) / FormatoCheckpoint.TamanhoPagina);
+                var grupo = new GrupoPaginas(primeira, Math.Min(FormatoCheckpoint.PaginasPorGrupo, total - primeira));
+                Parallel.For(0, grupo.quantidade, i => grupo.Classificar(memoria, i, comprimir));
+                return grupo;
+            }
+
+            void Classificar(byte[] memoria, int i, bool comprimir)
+            {
+                var pagina = Pagina(memoria, primeira + i);
+                if (pagina.IndexOfAnyExcept((byte)0) < 0)
+                {
+                    codificacoes[i] = Nula;
+                    return;
+                }
+
+                codificacoes[i] = FormatoCheckpoint.PaginaBruta;
+                comprimentos[i] = pagina.Length;
+                if (!comprimir) return;
+
+                var buffer = ArrayPool<byte>.Shared.Rent(BrotliEncoder.GetMaxCompressedLength(pagina.Length));
+                if (BrotliEncoder.TryCompress(pagina, buffer, out int n, FormatoCheckpoint.QualidadeBrotli, FormatoCheckpoint.JanelaBrotli)
+                    && n < pagina.Length)
+                {
+                    comprimidas[i] = buffer;
+                    comprimentos[i] = n;
+                    codificacoes[i] = FormatoCheckpoint.PaginaBrotli;
+                }
+                else
+                {
+                    ArrayPool<byte>.Shared.Return(buffer);
+                }
+            }
+
+            // retorna o número de páginas gravadas
+            public int Escrever(Stream destino, byte[] memoria)
+            {
+                Span<byte> cabecalho = stackalloc byte[9];
+                int gravadas = 0;
+                for (int i = 0; i < quantidade; i++)
+                {
+                    byte codificacao = codificacoes[i];
+                    if (codificacao == Nula) continue;
+
+                    BinaryPrimitives.WriteInt32LittleEndian(cabecalho, primeira + i);
+                    cabecalho[4] = codificacao;
+                    BinaryPrimitives.WriteInt32LittleEndian(cabecalho[5..], comprimentos[i]);
+                    destino.Write(cabecalho);
+
+                    if (codificacao == FormatoCheckpoint.PaginaBrotli) destino.Write(comprimidas[i].AsSpan(0, comprimentos[i]));
+                    else destino.Write(Pagina(memoria, primeira + i));
+                    gravadas++;
+                }
+                return gravadas;
+            }
+
+            public void Devolver()
+            {
+                for (int i = 0; i < quantidade; i++)
+                {
+                    if (comprimidas[i] is { } b) ArrayPool<byte>.Shared.Return(b);
+                    comprimidas[i] = null;
+                }
+            }
+        }
+
+        internal static Span<byte> Pagina(byte[] memoria, int indice)
+        {
+            long inicio = (long)indice * FormatoCheckpoint.TamanhoPagina;
+            int comprimento = (int)Math.Min(FormatoCheckpoint.TamanhoPagina, memoria.Length - inicio);
+            return memoria.AsSpan((int)inicio, comprimento);
+        }
+    }
+
+    /// <summary>
+    /// Lê um checkpoint gravado por <see cref="EscritorCheckpoint"/>, seção a seção.
+    /// Lança <see cref="InvalidDataException"/> se o conteúdo for inválido ou de versão futura.
+    /// </summary>
+    public sealed class LeitorCheckpoint : IDisposable
+    {
+        readonly Stream origem;
+        readonly BinaryReader leitor;
+        long comprimentoSecao;
+        bool secaoConsumida = true;
+
+        // leituras de seções usam blocos deste tamanho: comprimentos vêm do arquivo (não confiável)
+        // e a memória deve acompanhar os bytes recebidos, não o comprimento declarado
+        const int BlocoLeitura = 81920;
+
+        public LeitorCheckpoint(Stream origem)
+        {
+            this.origem = origem ?? throw new ArgumentNullException(nameof(origem));
+            leitor = new BinaryReader(origem, Encoding.UTF8, leaveOpen: true);
+
+            Span<byte> assinatura = stackalloc byte[8];
+            try
+            {
+                origem.ReadExactly(assinatura);
+            }
+            catch (EndOfStreamException)
+            {
+                throw new InvalidDataException("Checkpoint vazio ou truncado.");
+            }
+            if (!assinatura.SequenceEqual(FormatoCheckpoint.Assinatura))
+                throw new InvalidDataException("O conteúdo não é um checkpoint do simulador.");
+
+            try
+            {
+                Versao = leitor.ReadUInt16();
+                leitor.ReadUInt16();
+                if (Versao < 1 || Versao > FormatoCheckpoint.Versao)
+                    throw new InvalidDataException($"Versão de checkpoint não suportada: {Versao}.");
+
+                Ciclo = leitor.ReadInt64();
+                long criado = leitor.ReadInt64();
+                if (criado < DateTime.MinValue.Ticks || criado > DateTime.MaxValue.Ticks)
+                    throw new InvalidDataException("Data de criação do checkpoint inválida.");
+                CriadoEmUtc = new DateTime(criado, DateTimeKind.Utc);
+            }
+            catch (EndOfStreamException)
+            {
+                throw new InvalidDataException("Checkpoint truncado no cabeçalho.");
+            }
+        }
+
+        public int Versao { get; }
+        public long Ciclo { get; }
+        public DateTime CriadoEmUtc { get; }
+        public int PaginasRam { get; private set; }
+        public int PaginasLidas { get; private set; }
+        public long BytesRam { get; private set; }
+
+        /// <summary>
+        /// Avança para a próxima seção (descartando o que não foi lido da anterior).
+        /// Retorna false ao encontrar o fim.
+        /// </summary>
+        public bool ProximaSecao(out SecaoCheckpoint secao)
+        {
+            if (!secaoConsumida) Pular();
+
+            try
+            {
+                secao = (SecaoCheckpoint)leitor.ReadUInt32();
+                comprimentoSecao = leitor.ReadInt64();
+            }
+            catch (EndOfStreamException)
+            {
+                throw new InvalidDataException("Checkpoint truncado (sem marca de fim).");
+            }
+
+            if (secao == SecaoCheckpoint.Fim) return false;
+            if (comprimentoSecao < -1) throw new InvalidDataException("Comprimento de seção inválido.");
+            secaoConsumida = false;
+            return true;
+        }
+
+        /// <summary>
+        /// Conteúdo da seção atual (seções de tamanho conhecido).
+        /// </summary>
+        public BinaryReader LerSecao() => new(new MemoryStream(LerSecaoBruta(), writable: false), Encoding.UTF8);
+
+        /// <summary>
+        /// Bytes da seção atual (seções de tamanho conhecido), para aplicação posterior.
+        /// </summary>
+        public byte[] LerSecaoBruta()
+        {
+            if (comprimentoSecao < 0 || comprimentoSecao > Array.MaxLength) throw new InvalidDataException("Seção sem comprimento fixo.");
+            var dados = new MemoryStream((int)Math.Min(comprimentoSecao, BlocoLeitura));
+            var bloco = ArrayPool<byte>.Shared.Rent(BlocoLeitura);
+            try
+            {
+                for (long restante = comprimentoSecao; restante > 0;)
+                {
+                    int n = (int)Math.Min(restante, BlocoLeitura);
+                    LerExato(bloco.AsSpan(0, n));
+                    dados.Write(bloco, 0, n);
+                    restante -= n;
+                }
+            }
+            finally
+            {
+                ArrayPool<byte>.Shared.Return(bloco);
+            }
+            secaoConsumida = true;
+            return dados.Length == dados.Capacity ? dados.GetBuffer() : dados.ToArray();
+        }
+
+        /// <summary>
+        /// Lê a seção de RAM para <paramref name="memoria"/>, que deve ter o tamanho gravado.
+        /// Páginas ausentes ficam zeradas; páginas comprimidas são descomprimidas em paralelo.
+        /// </summary>
+        public void LerRam(byte[] memoria)
+        {
+            int tamanho = leitor.ReadInt32();
+            int pagina = leitor.ReadInt32();
+            if (tamanho != memoria.Length)
+                throw new InvalidDataException($"O checkpoint tem {tamanho} bytes de RAM; a máquina atual tem {memoria.Length}.");
+            if (pagina != FormatoCheckpoint.TamanhoPagina)
+                throw new InvalidDataException($"Tamanho de página não suportado: {pagina}.");
+
+            PaginasRam = (int)(((long)tamanho + pagina - 1) / pagina);
+            BytesRam = tamanho;
+            Array.Clear(memoria);
+
+            var indices = new int[FormatoCheckpoint.PaginasPorGrupo];
+            var buffers = new byte[FormatoCheckpoint.PaginasPorGrupo][];
+            var comprimentos = new int[FormatoCheckpoint.PaginasPorGrupo];
+            int pendentes = 0;
+
+            try
+            {
+                while (true)
+                {
+                    int indice = leitor.ReadInt32();
+                    if (indice < 0) break;
+                    if (indice >= PaginasRam) throw new InvalidDataException($"Página fora da RAM: {indice}.");
+
+                    byte codificacao = leitor.ReadByte();
+                    int comprimento = leitor.ReadInt32();
+                    var destino = EscritorCheckpoint.Pagina(memoria, indice);
+
+                    switch (codificacao)
+                    {
+                        case FormatoCheckpoint.PaginaBruta:
+                            if (comprimento != destino.Length) throw new InvalidDataException("Página bruta com comprimento inválido.");
+                            LerExato(destino);
+                            break;
+
+                        case FormatoCheckpoint.PaginaBrotli:
+                            if (comprimento <= 0 || comprimento > BrotliEncoder.GetMaxCompressedLength(destino.Length))
+                                throw new InvalidDataException("Página comprimida com comprimento inválido.");
+                            var buffer = ArrayPool<byte>.Shared.Rent(comprimento);
+                            buffers[pendentes] = buffer;
+                            LerExato(buffer.AsSpan(0, comprimento));
+                            indices[pendentes] = indice;
+                            comprimentos[pendentes] = comprimento;
+                            if (++pendentes == FormatoCheckpoint.PaginasPorGrupo)
+                            {
+                                // os buffers passam a ser devolvidos por Descomprimir
+                                pendentes = 0;
+                                Descomprimir(memoria, indices, buffers, comprimentos, FormatoCheckpoint.PaginasPorGrupo);
+                            }
+                            break;
+
+                        default:
+                            throw new InvalidDataException($"Codificação de página desconhecida: {codificacao}.");
+                    }
+                    PaginasLidas++;
+                }
+
+                int restantes = pendentes;
+                pendentes = 0;
+                Descomprimir(memoria, indices, buffers, comprimentos, restantes);
+            }
+            catch (EndOfStreamException)
+            {
+                throw new InvalidDataException("Checkpoint truncado na seção de RAM.");
+            }
+            finally
+            {
+                for (int i = 0; i < pendentes; i++) ArrayPool<byte>.Shared.Return(buffers[i]);
+            }
+            secaoConsumida = true;
+        }
+
+        static void Descomprimir(byte[] memoria, int[] indices, byte[][] buffers, int[] comprimentos, int quantidade)
+        {
+            try
+            {
+                Parallel.For(0, quantidade, i =>
+                {
+                    var destino = EscritorCheckpoint.Pagina(memoria, indices[i]);
+                    if (!BrotliDecoder.TryDecompress(buffers[i].AsSpan(0, comprimentos[i]), destino, out int n) || n != destino.Length)
+                        throw new InvalidDataException($"Página {indices[i]} corrompida.");
+                });
+            }
+            catch (AggregateException ex) when (ex.InnerException is InvalidDataException interna)
+            {
+                throw interna;
+            }
+            finally
+            {
+                for (int i = 0; i < quantidade; i++) ArrayPool<byte>.Shared.Return(buffers[i]);
+            }
+        }
+
+        // descarta a seção atual (seções desconhecidas ou não lidas)
+        void Pular()
+        {
+            var descarte = ArrayPool<byte>.Shared.Rent(BlocoLeitura);
+            try
+            {
+                if (comprimentoSecao >= 0)
+                {
+                    Descartar(comprimentoSecao, descarte);
+                }
+                else
+                {
+                    // seção transmitida (RAM): percorre os registros até o terminador
+                    leitor.ReadInt32();
+                    leitor.ReadInt32();
+                    while (leitor.ReadInt32() >= 0)
+                    {
+                        leitor.ReadByte();
+                        int n = leitor.ReadInt32();
+                        if (n < 0) throw new InvalidDataException("Registro de página inválido.");
+                        Descartar(n, descarte);
+                    }
+                }
+            }
+            catch (EndOfStreamException)
+            {
+                throw new InvalidDataException("Checkpoint truncado.");
+            }
+            finally
+            {
+                ArrayPool<byte>.Shared.Return(descarte);
+            }
+            secaoConsumida = true;
+        }
+
+        void Descartar(long quantidade, byte[] descarte)
+        {
+            for (long restante = quantidade; restante > 0;)
+            {
+                int n = (int)Math.Min(restante, BlocoLeitura);
+                LerExato(descarte.AsSpan(0, n));
+                restante -= n;
+            }
+        }
+
+        void LerExato(Span<byte> destino)
+        {
+            try
+            {
+                origem.ReadExactly(destino);
+            }
+            catch (EndOfStreamException)
+            {
+                throw new InvalidDataException("Checkpoint truncado.");
+            }
+        }
+
+        public InfoCheckpoint Info => new(Versao, Ciclo, CriadoEmUtc, PaginasRam, PaginasLidas, BytesRam);
+
+        public void Dispose() => leitor.Dispose();
+    }
+}
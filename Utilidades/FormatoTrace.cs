@@ -0,0 +1,640 @@
+using System;
+using System.Buffers;
+using System.Buffers.Binary;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.Compression;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Recebe as instruções executadas e os acessos à memória (rastreamento). Chamado no caminho
+    /// quente da CPU e da RAM: implementações devem ser baratas.
+    /// </summary>
+    public interface IObservadorExecucao
+    {
+        void Instrucao(int pc, uint opcode);
+        void Acesso(int endereco, int tamanho, bool escrita);
+    }
+
+    /// <summary>
+    /// Origem de registros de trace lidos em lotes (ver <see cref="LeitorTrace"/> e
+    /// <see cref="LeitorEnderecos"/>). <see cref="Ler"/> retorna 0 no fim.
+    /// </summary>
+    public interface IFonteTrace : IDisposable
+    {
+        int Ler(Span<RegistroTrace> destino);
+    }
+
+    public enum TipoRegistroTrace : byte
+    {
+        Instrucao = 0,
+        Leitura = 1,
+        Escrita = 2
+    }
+
+    /// <summary>
+    /// Registro decodificado de um trace. Em instruções, <see cref="Endereco"/> é o PC.
+    /// </summary>
+    public readonly record struct RegistroTrace(TipoRegistroTrace Tipo, long Ciclo, int Endereco, int Tamanho, uint Opcode);
+
+    /// <summary>
+    /// Resumo de um trace gravado.
+    /// </summary>
+    public record ResumoTrace(
+        long Registros,
+        long Instrucoes,
+        long Leituras,
+        long Escritas,
+        long CicloInicial,
+        long CicloFinal,
+        long BytesBrutos,
+        long BytesGravados,
+        long Esperas
+    );
+
+    /// <summary>
+    /// Formato binário de trace de execução (little-endian):
+    /// <code>
+    /// cabeçalho: "SIMPTRAC" | u16 versão | u16 flags (bit 0 = blocos comprimidos) | i64 ciclo inicial
+    /// blocos:    u32 registros | u32 bytes brutos | u32 bytes gravados | i64 ciclo base | dados
+    /// fim:       u32 0 | i64 ciclo final | i64 total de registros
+    /// </code>
+    /// Cada registro começa com um byte de marca: bits 0-1 = tipo (<see cref="TipoRegistroTrace"/>),
+    /// bit 2 = segue varint com o delta de ciclo em relação ao registro anterior, bit 3 = em
+    /// instruções, segue varint zigzag com o desvio do PC em relação ao sequencial (anterior + 4);
+    /// em acessos, segue varint com o tamanho (omitido quando 4). Depois vêm, na instrução, o
+    /// opcode em varint; no acesso, o endereço em varint zigzag relativo ao último acesso do mesmo
+    /// tipo. Os deltas recomeçam a cada bloco (ciclo = ciclo base, PC e endereços = 0), de modo
+    /// que os blocos são decodificáveis de forma independente — e em paralelo.
+    /// </summary>
+    public static class FormatoTrace
+    {
+        public const int Versao = 1;
+
+        // dados brutos por bloco
+        public const int TamanhoBloco = 256 * 1024;
+
+        internal static ReadOnlySpan<byte> Assinatura => "SIMPTRAC"u8;
+
+        internal const ushort FlagComprimido = 1;
+
+        internal const byte MarcaCiclo = 1 << 2;
+        internal const byte MarcaExtra = 1 << 3;
+
+        // registro mais longo: marca + 3 varints de até 10 bytes
+        internal const int MaiorRegistro = 31;
+
+        internal const int TamanhoCabecalhoBloco = 20;
+
+        // Brotli qualidade 1: mantém o escritor à frente da simulação
+        internal const int QualidadeBrotli = 1;
+        internal const int JanelaBrotli = 22;
+
+        internal static int EscreverVarint(Span<byte> destino, ulong valor)
+        {
+            int i = 0;
+            while (valor >= 0x80)
+            {
+                destino[i++] = (byte)(valor | 0x80);
+                valor >>= 7;
+            }
+            destino[i++] = (byte)valor;
+            return i;
+        }
+
+        internal static ulong ZigZag(long v) => (ulong)((v << 1) ^ (v >> 63));
+        internal static long DesfazerZigZag(ulong v) => (long)(v >> 1) ^ -(long)(v & 1);
+    }
+
+    /// <summary>
+    /// Grava um trace a partir dos ganchos da CPU e da RAM. Os registros são codificados no
+    /// thread que executa a simulação em blocos de <see cref="FormatoTrace.TamanhoBloco"/>;
+    /// blocos cheios seguem para um thread dedicado que os comprime e grava. A fila entre os
+    /// dois é limitada: se o disco não acompanhar, a simulação espera (memória constante).
+    /// </summary>
+    public sealed class EscritorTrace : IObservadorExecucao, IDisposable
+    {
+        readonly Stream destino;
+        readonly Func<long> relogio;
+        readonly bool comprimir;
+        readonly BlockingCollection<Bloco> fila;
+        readonly Thread gravador;
+        readonly object sync = new();
+
+        // bloco em preenchimento e estado dos deltas (reiniciado a cada bloco)
+        Bloco atual;
+        long cicloAnterior;
+        int pcAnterior, leituraAnterior, escritaAnterior;
+
+        long instrucoes, leituras, escritas, bytesBrutos, bytesGravados, esperas;
+        Exception? falha;
+        ResumoTrace? resumo;
+
+        sealed class Bloco
+        {
+            public byte[] Dados = ArrayPool<byte>.Shared.Rent(FormatoTrace.TamanhoBloco + FormatoTrace.MaiorRegistro);
+            public int Comprimento;
+            public int Registros;
+            public long CicloBase;
+        }
+
+        /// <param name="relogio">Ciclo atual da simulação, consultado a cada registro.</param>
+        /// <param name="blocosEmVoo">Blocos cheios aguardando gravação antes de a simulação esperar.</param>
+        public EscritorTrace(Stream destino, Func<long> relogio, bool comprimir = true, int blocosEmVoo = 8)
+        {
+            this.destino = destino ?? throw new ArgumentNullException(nameof(destino));
+            this.relogio = relogio ?? throw new ArgumentNullException(nameof(relogio));
+            this.comprimir = comprimir;
+            fila = new BlockingCollection<Bloco>(Math.Max(1, blocosEmVoo));
+
+            CicloInicial = relogio();
+            Span<byte> cabecalho = stackalloc byte[20];
+            FormatoTrace.Assinatura.CopyTo(cabecalho);
+            BinaryPrimitives.WriteUInt16LittleEndian(cabecalho[8..], FormatoTrace.Versao);
+            BinaryPrimitives.WriteUInt16LittleEndian(cabecalho[10..], comprimir ? FormatoTrace.FlagComprimido : (ushort)0);
+            BinaryPrimitives.WriteInt64LittleEndian(cabecalho[12..], CicloInicial);
+            destino.Write(cabecalho);
+
+            atual = NovoBloco(CicloInicial);
+            gravador = new Thread(Gravar) { IsBackground = true, Name = "EscritorTrace" };
+            gravador.Start();
+        }
+
+        public long CicloInicial { get; }
+
+        public long Registros { get { lock (sync) return instrucoes + leituras + escritas; } }
+
+        public void Instrucao(int pc, uint opcode)
+        {
+            lock (sync)
+            {
+                if (resumo is not null) return;
+                var dados = Reservar(out int i);
+                int marca = i++;
+                byte tipo = (byte)TipoRegistroTrace.Instrucao;
+
+                i += Ciclo(dados, i, ref tipo);
+                int desvio = pc - (pcAnterior + 4);
+                if (desvio != 0)
+                {
+                    tipo |= FormatoTrace.MarcaExtra;
+                    i += FormatoTrace.EscreverVarint(dados.AsSpan(i), FormatoTrace.ZigZag(desvio));
+                }
+                i += FormatoTrace.EscreverVarint(dados.AsSpan(i), opcode);
+
+                dados[marca] = tipo;
+                pcAnterior = pc;
+                instrucoes++;
+                Confirmar(i);
+            }
+        }
+
+        public void Acesso(int endereco, int tamanho, bool escrita)
+        {
+            lock (sync)
+            {
+                if (resumo is not null) return;
+                var dados = Reservar(out int i);
+                int marca = i++;
+                byte tipo = (byte)(escrita ? TipoRegistroTrace.Escrita : TipoRegistroTrace.Leitura);
+
+                i += Ciclo(dados, i, ref tipo);
+                if (tamanho != 4)
+                {
+                    tipo |= FormatoTrace.MarcaExtra;
+                    i += FormatoTrace.EscreverVarint(dados.AsSpan(i), (uint)tamanho);
+                }
+                ref int anterior = ref escrita ? ref escritaAnterior : ref leituraAnterior;
+                i += FormatoTrace.EscreverVarint(dados.AsSpan(i), FormatoTrace.ZigZag((long)endereco - anterior));
+
+                dados[marca] = tipo;
+                anterior = endereco;
+                if (escrita) escritas++;
+                else leituras++;
+                Confirmar(i);
+            }
+        }
+
+        /// <summary>
+        /// Grava o bloco pendente e a marca de fim, aguarda o thread de gravação e descarrega o
+        /// stream. Lança <see cref="IOException"/> se a gravação tiver falhado. Idempotente.
+        /// </summary>
+        public ResumoTrace Finalizar()
+        {
+            Bloco ultimo;
+            lock (sync)
+            {
+                if (resumo is not null) return resumo;
+                ultimo = atual;
+                resumo = new ResumoTrace(instrucoes + leituras + escritas, instrucoes, leituras, escritas,
+                    CicloInicial, relogio(), 0, 0, esperas);
+            }
+
+            if (ultimo.Registros > 0) Enfileirar(ultimo);
+            else ArrayPool<byte>.Shared.Return(ultimo.Dados);
+            fila.CompleteAdding();
+            gravador.Join();
+
+            if (falha is null)
+            {
+                try
+                {
+                    Span<byte> fim = stackalloc byte[20];
+                    BinaryPrimitives.WriteUInt32LittleEndian(fim, 0);
+                    BinaryPrimitives.WriteInt64LittleEndian(fim[4..], resumo.CicloFinal);
+                    BinaryPrimitives.WriteInt64LittleEndian(fim[12..], resumo.Registros);
+                    destino.Write(fim);
+                    destino.Flush();
+                    bytesGravados += fim.Length;
+                }
+                catch (Exception ex)
+                {
+                    falha = ex;
+                }
+            }
+
+            resumo = resumo with { BytesBrutos = bytesBrutos, BytesGravados = bytesGravados };
+            if (falha is not null) throw new IOException("Falha ao gravar o trace.", falha);
+            return resumo;
+        }
+
+        public void Dispose()
+        {
+            try { Finalizar(); }
+            catch (IOException) { }
+            fila.Dispose();
+        }
+
+        // espaço para um registro no bloco atual (troca de bloco se preciso)
+        byte[] Reservar(out int posicao)
+        {
+            if (atual.Comprimento >= FormatoTrace.TamanhoBloco)
+            {
+                var cheio = atual;
+                atual = NovoBloco(cicloAnterior);
+                Enfileirar(cheio);
+            }
+            posicao = atual.Comprimento;
+            return atual.Dados;
+        }
+
+        void Confirmar(int fim)
+        {
+            atual.Comprimento = fim;
+            atual.Registros++;
+        }
+
+        int Ciclo(byte[] dados, int i, ref byte tipo)
+        {
+            long ciclo = relogio();
+            long delta = ciclo - cicloAnterior;
+            if (delta == 0) return 0;
+            cicloAnterior = ciclo;
+            tipo |= FormatoTrace.MarcaCiclo;
+            return FormatoTrace.EscreverVarint(dados.AsSpan(i), FormatoTrace.ZigZag(delta));
+        }
+
+        Bloco NovoBloco(long cicloBase)
+        {
+            cicloAnterior = cicloBase;
+            pcAnterior = -4;
+            leituraAnterior = escritaAnterior = 0;
+            return new Bloco { CicloBase = cicloBase };
+        }
+
+        void Enfileirar(Bloco bloco)
+        {
+            if (fila.TryAdd(bloco)) return;
+            // fila cheia: a simulação espera o gravador (contabilizado para diagnóstico)
+            esperas++;
+            try
+            {
+                fila.Add(bloco);
+            }
+            catch (InvalidOperationException)
+            {
+                ArrayPool<byte>.Shared.Return(bloco.Dados);
+            }
+        }
+
+        void Gravar()
+        {
+            Span<byte> cabecalho = stackalloc byte[FormatoTrace.TamanhoCabecalhoBloco];
+            foreach (var bloco in fila.GetConsumingEnumerable())
+            {
+                byte[]? comprimido = null;
+                try
+                {
+                    if (falha is not null) continue;
+
+                    var bruto = bloco.Dados.AsSpan(0, bloco.Comprimento);
+                    var gravar = bruto;
+                    if (comprimir)
+                    {
+                        comprimido = ArrayPool<byte>.Shared.Rent(BrotliEncoder.GetMaxCompressedLength(bruto.Length));
+                        if (BrotliEncoder.TryCompress(bruto, comprimido, out int n, FormatoTrace.QualidadeBrotli, FormatoTrace.JanelaBrotli))
+                            gravar = comprimido.AsSpan(0, n);
+                        else
+                            throw new InvalidOperationException("Falha ao comprimir bloco de trace.");
+                    }
+
+                    BinaryPrimitives.WriteUInt32LittleEndian(cabecalho, (uint)bloco.Registros);
+                    BinaryPrimitives.WriteUInt32LittleEndian(cabecalho[4..], (uint)bruto.Length);
+                    BinaryPrimitives.WriteUInt32LittleEndian(cabecalho[8..], (uint)gravar.Length);
+                    BinaryPrimitives.WriteInt64LittleEndian(cabecalho[12..], bloco.CicloBase);
+                    destino.Write(cabecalho);
+                    destino.Write(gravar);
+
+                    bytesBrutos += bruto.Length;
+                    bytesGravados += cabecalho.Length + gravar.Length;
+                }
+                catch (Exception ex)
+                {
+                    // a simulação continua; o erro aparece em Finalizar
+                    falha = ex;
+                }
+                finally
+                {
+                    if (comprimido is not null) ArrayPool<byte>.Shared.Return(comprimido);
+                    ArrayPool<byte>.Shared.Return(bloco.Dados);
+                }
+            }
+        }
+    }
+
+    /// <summary>
+    /// Lê um trace gravado por <see cref="EscritorTrace"/>. Os blocos seguintes são lidos e
+    /// descomprimidos em paralelo, à frente do consumidor, com memória limitada a
+    /// <c>blocosAdiantados</c> blocos. Use <see cref="Ler(Span{RegistroTrace})"/> em laços quentes.
+    /// Lança <see cref="InvalidDataException"/> se o conteúdo for inválido ou truncado.
+    /// </summary>
+    public sealed class LeitorTrace : IFonteTrace
+    {
+        readonly Stream origem;
+        readonly bool comprimido;
+        readonly int blocosAdiantados;
+        readonly Queue<Task<BlocoLido>> adiantados = new();
+        bool fimLido;
+
+        // bloco em decodificação
+        BlocoLido? atual;
+        int posicao, restantes;
+        long ciclo;
+        int pcAnterior, leituraAnterior, escritaAnterior;
+
+        sealed class BlocoLido
+        {
+            public required byte[] Dados;
+            public required int Comprimento;
+            public required int Registros;
+            public required long CicloBase;
+        }
+
+        public LeitorTrace(Stream origem, int blocosAdiantados = 0)
+        {
+            this.origem = origem ?? throw new ArgumentNullException(nameof(origem));
+            this.blocosAdiantados = blocosAdiantados > 0 ? blocosAdiantados : Math.Max(2, Environment.ProcessorCount);
+
+            Span<byte> cabecalho = stackalloc byte[20];
+            LerExato(cabecalho, "Trace vazio ou truncado.");
+            if (!cabecalho[..8].SequenceEqual(FormatoTrace.Assinatura))
+                throw new InvalidDataException("O conteúdo não é um trace do simulador.");
+
+            Versao = BinaryPrimitives.ReadUInt16LittleEndian(cabecalho[8..]);
+            if (Versao < 1 || Versao > FormatoTrace.Versao)
+                throw new InvalidDataException($"Versão de trace não suportada: {Versao}.");
+            comprimido = (BinaryPrimitives.ReadUInt16LittleEndian(cabecalho[10..]) & FormatoTrace.FlagComprimido) != 0;
+            CicloInicial = BinaryPrimitives.ReadInt64LittleEndian(cabecalho[12..]);
+            CicloFinal = CicloInicial;
+        }
+
+        public int Versao { get; }
+        public long CicloInicial { get; }
+
+        /// <summary>Conhecido ao fim da leitura.</summary>
+        public long CicloFinal { get; private set; }
+
+        public long RegistrosLidos { get; private set; }
+
+        /// <summary>
+        /// Preenche <paramref name="destino"/> com os próximos registros; retorna 0 no fim do trace.
+        /// </summary>
+        public int Ler(Span<RegistroTrace> destino)
+        {
+            int n = 0;
+            while (n < destino.Length)
+            {
+                if (restantes == 0 && !ProximoBloco()) break;
+                n += Decodificar(destino[n..]);
+            }
+            RegistrosLidos += n;
+            return n;
+        }
+
+        public bool Proximo(out RegistroTrace registro)
+        {
+            Span<RegistroTrace> um = stackalloc RegistroTrace[1];
+            bool ok = Ler(um) == 1;
+            registro = ok ? um[0] : default;
+            return ok;
+        }
+
+        public IEnumerable<RegistroTrace> Registros()
+        {
+            var lote = new RegistroTrace[4096];
+            int n;
+            while ((n = Ler(lote)) > 0)
+            {
+                for (int i = 0; i < n; i++) yield return lote[i];
+            }
+        }
+
+        int Decodificar(Span<RegistroTrace> destino)
+        {
+            var dados = atual!.Dados;
+            int fim = atual.Comprimento;
+            int n = 0;
+            int i = posicao;
+
+            while (n < destino.Length && restantes > 0)
+            {
+                if (i >= fim) throw new InvalidDataException("Bloco de trace truncado.");
+                byte marca = dados[i++];
+                if ((marca & FormatoTrace.MarcaCiclo) != 0) ciclo += FormatoTrace.DesfazerZigZag(Varint(dados, ref i, fim));
+
+                var tipo = (TipoRegistroTrace)(marca & 3);
+                switch (tipo)
+                {
+                    case TipoRegistroTrace.Instrucao:
+                    {
+                        int pc = pcAnterior + 4;
+                        if ((marca & FormatoTrace.MarcaExtra) != 0) pc += (int)FormatoTrace.DesfazerZigZag(Varint(dados, ref i, fim));
+                        uint opcode = (uint)Varint(dados, ref i, fim);
+                        pcAnterior = pc;
+                        destino[n] = new RegistroTrace(tipo, ciclo, pc, 4, opcode);
+                        break;
+                    }
+                    case TipoRegistroTrace.Leitura:
+                    case TipoRegistroTrace.Escrita:
+                    {
+                        int tamanho = (marca & FormatoTrace.MarcaExtra) != 0 ? (int)Varint(dados, ref i, fim) : 4;
+                        ref int anterior = ref tipo == TipoRegistroTrace.Escrita ? ref escritaAnterior : ref leituraAnterior;
+                        int endereco = (int)(anterior + FormatoTrace.DesfazerZigZag(Varint(dados, ref i, fim)));
+                        anterior = endereco;
+                        destino[n] = new RegistroTrace(tipo, ciclo, endereco, tamanho, 0);
+                        break;
+                    }
+                    default:
+                        throw new InvalidDataException($"Tipo de registro desconhecido: {marca & 3}.");
+                }
+                n++;
+                restantes--;
+            }
+
+            posicao = i;
+            if (restantes == 0) Devolver();
+            return n;
+        }
+
+        static ulong Varint(byte[] dados, ref int i, int fim)
+        {
+            ulong valor = 0;
+            for (int deslocamento = 0; deslocamento < 64; deslocamento += 7)
+            {
+                if (i >= fim) throw new InvalidDataException("Varint truncado.");
+                byte b = dados[i++];
+                valor |= (ulong)(b & 0x7F) << deslocamento;
+                if (b < 0x80) return valor;
+            }
+            throw new InvalidDataException("Varint inválido.");
+        }
+
+        bool ProximoBloco()
+        {
+            Devolver();
+            while (adiantados.Count < blocosAdiantados && !fimLido) Adiantar();
+            if (adiantados.Count == 0) return false;
+
+            BlocoLido bloco;
+            try
+            {
+                bloco = adiantados.Dequeue().GetAwaiter().GetResult();
+            }
+            catch (InvalidDataException)
+            {
+                Descartar();
+                throw;
+            }
+
+            atual = bloco;
+            posicao = 0;
+            restantes = bloco.Registros;
+            ciclo = bloco.CicloBase;
+            pcAnterior = -4;
+            leituraAnterior = escritaAnterior = 0;
+            if (restantes == 0) Devolver();
+            return restantes > 0 || ProximoBloco();
+        }
+
+        // lê o próximo bloco do stream e agenda a descompressão
+        void Adiantar()
+        {
+            Span<byte> cabecalho = stackalloc byte[FormatoTrace.TamanhoCabecalhoBloco];
+            LerExato(cabecalho[..4], "Trace truncado (sem marca de fim).");
+            int registros = (int)BinaryPrimitives.ReadUInt32LittleEndian(cabecalho);
+            if (registros == 0)
+            {
+                Span<byte> fim = stackalloc byte[16];
+                LerExato(fim, "Trace truncado na marca de fim.");
+                CicloFinal = BinaryPrimitives.ReadInt64LittleEndian(fim);
+                fimLido = true;
+                return;
+            }
+
+            LerExato(cabecalho[4..], "Trace truncado.");
+            int bruto = (int)BinaryPrimitives.ReadUInt32LittleEndian(cabecalho[4..]);
+            int gravado = (int)BinaryPrimitives.ReadUInt32LittleEndian(cabecalho[8..]);
+            long cicloBase = BinaryPrimitives.ReadInt64LittleEndian(cabecalho[12..]);
+            if (registros < 0 || bruto <= 0 || bruto > FormatoTrace.TamanhoBloco + FormatoTrace.MaiorRegistro
+                || gravado <= 0 || gravado > BrotliEncoder.GetMaxCompressedLength(bruto))
+                throw new InvalidDataException("Cabeçalho de bloco inválido.");
+
+            var lido = ArrayPool<byte>.Shared.Rent(gravado);
+            try
+            {
+                LerExato(lido.AsSpan(0, gravado), "Trace truncado.");
+            }
+            catch
+            {
+                ArrayPool<byte>.Shared.Return(lido);
+                throw;
+            }
+
+            if (!comprimido)
+            {
+                if (gravado != bruto) throw new InvalidDataException("Bloco bruto com comprimento inválido.");
+                adiantados.Enqueue(Task.FromResult(new BlocoLido { Dados = lido, Comprimento = bruto, Registros = registros, CicloBase = cicloBase }));
+                return;
+            }
+
+            adiantados.Enqueue(Task.Run(() =>
+            {
+                var dados = ArrayPool<byte>.Shared.Rent(bruto);
+                try
+                {
+                    if (!BrotliDecoder.TryDecompress(lido.AsSpan(0, gravado), dados, out int n) || n != bruto)
+                        throw new InvalidDataException("Bloco de trace corrompido.");
+                }
+                catch
+                {
+                    ArrayPool<byte>.Shared.Return(dados);
+                    throw;
+                }
+                finally
+                {
+                    ArrayPool<byte>.Shared.Return(lido);
+                }
+                return new BlocoLido { Dados = dados, Comprimento = bruto, Registros = registros, CicloBase = cicloBase };
+            }));
+        }
+
+        void Devolver()
+        {
+            if (atual is null) return;
+            ArrayPool<byte>.Shared.Return(atual.Dados);
+            atual = null;
+        }
+
+        // aguarda e devolve os blocos já agendados
+        void Descartar()
+        {
+            while (adiantados.Count > 0)
+            {
+                try { ArrayPool<byte>.Shared.Return(adiantados.Dequeue().GetAwaiter().GetResult().Dados); }
+                catch (InvalidDataException) { }
+            }
+        }
+
+        void LerExato(Span<byte> destino, string mensagem)
+        {
+            try
+            {
+                origem.ReadExactly(destino);
+            }
+            catch (EndOfStreamException)
+            {
+                throw new InvalidDataException(mensagem);
+            }
+        }
+
+        public void Dispose()
+        {
+            Devolver();
+            Descartar();
+        }
+    }
+}
@@ -0,0 +1,317 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Threading;
+using System.Text.Json.Serialization;
+using System.Threading.Channels;
+using System.Threading.Tasks;
+using Microsoft.Extensions.Hosting;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    [JsonConverter(typeof(JsonStringEnumConverter))]
+    public enum StatusJob
+    {
+        Pendente,
+        Executando,
+        Concluido,
+        Cancelado,
+        Falhou
+    }
+
+    /// <summary>
+    /// Progresso registrado no último checkpoint de um job.
+    /// </summary>
+    public record CheckpointJob(
+        DateTime MomentoUtc,
+        long CiclosExecutados,
+        long Instrucoes,
+        double CiclosPorSegundo,
+        CpuSnapshot Cpu,
+        CacheSnapshot Cache
+    );
+
+    /// <summary>
+    /// Visão imutável de um job para a API.
+    /// </summary>
+    public record EstadoJob(
+        string Id,
+        string Nome,
+        StatusJob Status,
+        long CiclosSolicitados,
+        long CiclosExecutados,
+        double Progresso,
+        DateTime CriadoEm,
+        DateTime? IniciadoEm,
+        DateTime? ConcluidoEm,
+        CheckpointJob? UltimoCheckpoint,
+        RunResult? Resultado,
+        string? Erro
+    );
+
+    /// <summary>
+    /// Experimento longo executado em segundo plano numa máquina isolada.
+    /// </summary>
+    public sealed class JobSimulacao
+    {
+        readonly object sync = new();
+        readonly CancellationTokenSource cts = new();
+
+        internal JobSimulacao(string nome, Configuracoes config, CargaTrabalho carga, int ramMB)
+        {
+            Id = Guid.NewGuid().ToString("N");
+            Nome = nome;
+            Config = config.Clone();
+            Carga = carga;
+            RamMB = ramMB;
+            CriadoEm = DateTime.UtcNow;
+        }
+
+        public string Id { get; }
+        public string Nome { get; }
+        public Configuracoes Config { get; }
+        public CargaTrabalho Carga { get; }
+        public int RamMB { get; }
+        public DateTime CriadoEm { get; }
+
+        public StatusJob Status { get { lock (sync) return status; } }
+        public bool Finalizado => Status is StatusJob.Concluido or StatusJob.Cancelado or StatusJob.Falhou;
+
+        internal CancellationToken Token => cts.Token;
+
+        StatusJob status = StatusJob.Pendente;
+        DateTime? iniciadoEm, concluidoEm;
+        long ciclosExecutados;
+        CheckpointJob? checkpoint;
+        RunResult? resultado;
+        string? erro;
+
+        public EstadoJob ObterEstado()
+        {
+            lock (sync)
+            {
+                return new EstadoJob(Id, Nome, status, Carga.Ciclos, ciclosExecutados,
+                    Carga.Ciclos > 0 ? (double)ciclosExecutados / Carga.Ciclos : 1.0,
+                    CriadoEm, iniciadoEm, concluidoEm, checkpoint, resultado, erro);
+            }
+        }
+
+        /// <summary>
+        /// Solicita o cancelamento. Jobs pendentes são cancelados imediatamente.
+        /// </summary>
+        public void Cancelar()
+        {
+            lock (sync)
+            {
+                if (status == StatusJob.Pendente)
+                {
+                    status = StatusJob.Cancelado;
+                    concluidoEm = DateTime.UtcNow;
+                }
+            }
+            cts.Cancel();
+        }
+
+        // retorna falso se o job foi cancelado antes de começar
+        internal bool Iniciar()
+        {
+            lock (sync)
+            {
+                if (status != StatusJob.Pendente) return false;
+                status = StatusJob.Executando;
+                iniciadoEm = DateTime.UtcNow;
+                return true;
+            }
+        }
+
+        internal void RegistrarCheckpoint(CheckpointJob cp)
+        {
+            lock (sync)
+            {
+                ciclosExecutados = cp.CiclosExecutados;
+                checkpoint = cp;
+            }
+        }
+
+        internal void Finalizar(StatusJob final, RunResult? run, string? mensagem)
+        {
+            lock (sync)
+            {
+                status = final;
+                resultado = run;
+                erro = mensagem;
+                if (run is not null) ciclosExecutados = run.CiclosExecutados;
+                concluidoEm = DateTime.UtcNow;
+            }
+        }
+
+        internal DateTime? ConcluidoEm { get { lock (sync) return concluidoEm; } }
+    }
+
+    /// <summary>
+    /// Limites do gerenciador de jobs.
+    /// </summary>
+    public class OpcoesJobs
+    {
+        /// <summary>Jobs executando ao mesmo tempo.</summary>
+        public int MaxConcorrencia { get; set; } = Math.Max(1, Environment.ProcessorCount / 2);
+
+        /// <summary>Jobs aceitos aguardando execução.</summary>
+        public int MaxPendentes { get; set; } = 64;
+
+        /// <summary>Intervalo (tempo de host) entre checkpoints de progresso.</summary>
+        public TimeSpan IntervaloCheckpoint { get; set; } = TimeSpan.FromMilliseconds(500);
+
+        /// <summary>Por quanto tempo jobs finalizados ficam consultáveis.</summary>
+        public TimeSpan Retencao { get; set; } = TimeSpan.FromHours(1);
+    }
+
+    /// <summary>
+    /// Fila de jobs de simulação executados por um número limitado de trabalhadores em segundo
+    /// plano (serviço hospedado). Cada job roda numa máquina isolada, em lotes dimensionados para
+    /// durar aproximadamente <see cref="OpcoesJobs.IntervaloCheckpoint"/>; ao fim de cada lote o
+    /// progresso é registrado e o cancelamento é verificado. A máquina web global não é tocada.
+    /// </summary>
+    public sealed class GerenciadorJobs : BackgroundService
+    {
+        // lote inicial, antes de conhecer a vazão da máquina
+        const long LoteInicial = 262_144;
+
+        readonly ConcurrentDictionary<string, JobSimulacao> jobs = new();
+        readonly Channel<JobSimulacao> fila = Channel.CreateUnbounded<JobSimulacao>(new UnboundedChannelOptions { SingleWriter = false });
+        int pendentes;
+
+        public GerenciadorJobs(OpcoesJobs? opcoes = null)
+        {
+            Opcoes = opcoes ?? new OpcoesJobs();
+        }
+
+        public OpcoesJobs Opcoes { get; }
+
+        /// <summary>
+        /// Enfileira um job. Lança <see cref="InvalidOperationException"/> se a fila estiver cheia.
+        /// </summary>
+        public JobSimulacao Enfileirar(string? nome, Configuracoes config, CargaTrabalho carga, int ramMB = 1)
+        {
+            if (config is null) throw new ArgumentNullException(nameof(config));
+            if (carga is null) throw new ArgumentNullException(nameof(carga));
+            config.Validate();
+
+            if (Interlocked.Increment(ref pendentes) > Opcoes.MaxPendentes)
+            {
+                Interlocked.Decrement(ref pendentes);
+                throw new InvalidOperationException("Fila de jobs cheia.");
+            }
+
+            var job = new JobSimulacao(nome ?? carga.Nome, config, carga, ramMB);
+            jobs[job.Id] = job;
+            if (!fila.Writer.TryWrite(job))
+            {
+                jobs.TryRemove(job.Id, out _);
+                Interlocked.Decrement(ref pendentes);
+                throw new InvalidOperationException("Gerenciador de jobs encerrado.");
+            }
+            return job;
+        }
+
+        public JobSimulacao? Obter(string id) => jobs.TryGetValue(id, out var job) ? job : null;
+
+        public IReadOnlyList<EstadoJob> Listar() =>
+            jobs.Values.OrderBy(j => j.CriadoEm).Select(j => j.ObterEstado()).ToList();
+
+        /// <summary>
+        /// Cancela um job ativo; um job já finalizado é removido do histórico.
+        /// </summary>
+        public bool CancelarOuRemover(string id)
+        {
+            if (!jobs.TryGetValue(id, out var job)) return false;
+            if (job.Finalizado) jobs.TryRemove(id, out _);
+            else job.Cancelar();
+            return true;
+        }
+
+        protected override Task ExecuteAsync(CancellationToken stoppingToken)
+        {
+            var trabalhadores = Enumerable.Range(0, Math.Max(1, Opcoes.MaxConcorrencia))
+                .Select(_ => Task.Run(() => Trabalhador(stoppingToken), CancellationToken.None));
+            return Task.WhenAll(trabalhadores);
+        }
+
+        async Task Trabalhador(CancellationToken stoppingToken)
+        {
+            try
+            {
+                await foreach (var job in fila.Reader.ReadAllAsync(stoppingToken).ConfigureAwait(false))
+                {
+                    Interlocked.Decrement(ref pendentes);
+                    if (!job.Iniciar()) continue;
+
+                    using var vinculado = CancellationTokenSource.CreateLinkedTokenSource(job.Token, stoppingToken);
+                    Executar(job, vinculado.Token);
+                    Purgar();
+                }
+            }
+            catch (OperationCanceledException)
+            {
+                // host encerrando
+            }
+        }
+
+        void Executar(JobSimulacao job, CancellationToken ct)
+        {
+            try
+            {
+                var state = new SimulationState { Config = job.Config.Clone(), Ram = new RAM.RamState(job.RamMB) };
+                if (job.Carga.Imagem is { Length: > 0 })
+                    state.Ram.Escrever(job.Carga.EnderecoCarga, job.Carga.Imagem);
+
+                using var engine = new SimulationEngine(state);
+
+                long executados = 0, instrucoes = 0;
+                var duracao = TimeSpan.Zero;
+                long lote = LoteInicial;
+                double alvoSegundos = Math.Max(0.01, Opcoes.IntervaloCheckpoint.TotalSeconds);
+
+                while (executados < job.Carga.Ciclos && !ct.IsCancellationRequested)
+                {
+                    var run = engine.RunCycles(Math.Min(lote, job.Carga.Ciclos - executados), ct);
+                    executados += run.CiclosExecutados;
+                    instrucoes += run.InstrucoesExecutadas;
+                    duracao += run.Duracao;
+
+                    var snap = state.GetSnapshot(0, 0);
+                    job.RegistrarCheckpoint(new CheckpointJob(DateTime.UtcNow, executados, instrucoes, run.CiclosPorSegundo, snap.Cpu, snap.Cache));
+
+                    // próximo lote dimensionado pela vazão observada
+                    if (run.CiclosPorSegundo > 0)
+                        lote = Math.Clamp((long)(run.CiclosPorSegundo * alvoSegundos), 1_024, 1L << 32);
+                }
+
+                var resultado = RunResult.Criar(executados, instrucoes, duracao, false, ct.IsCancellationRequested);
+                job.Finalizar(ct.IsCancellationRequested ? StatusJob.Cancelado : StatusJob.Concluido, resultado, null);
+            }
+            catch (Exception ex)
+            {
+                job.Finalizar(StatusJob.Falhou, null, ex.Message);
+            }
+        }
+
+        // descarta jobs finalizados há mais tempo que a retenção
+        void Purgar()
+        {
+            var limite = DateTime.UtcNow - Opcoes.Retencao;
+            foreach (var job in jobs.Values)
+            {
+                if (job.Finalizado && job.ConcluidoEm < limite) jobs.TryRemove(job.Id, out _);
+            }
+        }
+
+        public override void Dispose()
+        {
+            fila.Writer.TryComplete();
+            base.Dispose();
+        }
+    }
+}
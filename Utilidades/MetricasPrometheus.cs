@@ -0,0 +1,145 @@
+using System;
+using System.Buffers.Text;
+using System.IO;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Renderiza os contadores do simulador no formato de exposição texto do Prometheus
+    /// (<c>text/plain; version=0.0.4</c>). O texto é montado num buffer UTF-8 pré-alocado,
+    /// reaproveitado entre coletas: uma coleta não aloca e não adquire os locks da simulação
+    /// (os contadores são lidos diretamente; um valor pode estar um lote atrasado).
+    /// Coletas concorrentes são serializadas entre si por um semáforo próprio.
+    /// </summary>
+    public sealed class MetricasPrometheus
+    {
+        public const string ContentType = "text/plain; version=0.0.4; charset=utf-8";
+
+        readonly SimulationState sim;
+        readonly SimulationEngine engine;
+        readonly SemaphoreSlim coleta = new(1, 1);
+        byte[] buffer = new byte[16 * 1024];
+        int pos;
+
+        public MetricasPrometheus(SimulationState sim, SimulationEngine engine)
+        {
+            this.sim = sim ?? throw new ArgumentNullException(nameof(sim));
+            this.engine = engine ?? throw new ArgumentNullException(nameof(engine));
+        }
+
+        /// <summary>
+        /// Renderiza e escreve a exposição completa em <paramref name="destino"/>.
+        /// </summary>
+        public async Task EscreverAsync(Stream destino, CancellationToken ct = default)
+        {
+            await coleta.WaitAsync(ct).ConfigureAwait(false);
+            try
+            {
+                int n = Renderizar();
+                await destino.WriteAsync(buffer.AsMemory(0, n), ct).ConfigureAwait(false);
+            }
+            finally
+            {
+                coleta.Release();
+            }
+        }
+
+        /// <summary>
+        /// Renderiza no buffer interno e retorna o número de bytes escritos.
+        /// Exige exclusividade: use <see cref="EscreverAsync"/> a partir de requisições.
+        /// </summary>
+        internal int Renderizar()
+        {
+            pos = 0;
+
+            var m = engine.Metricas;
+            Contador("simulador_ciclos_total"u8, "Ciclos simulados (relógio global)."u8, sim.CicloAtual);
+            Contador("simulador_cpu_ciclos_total"u8, "Ciclos contabilizados pela CPU."u8, m.TotalCycles);
+            Contador("simulador_instrucoes_total"u8, "Instruções executadas."u8, m.InstructionsExecuted);
+            Contador("simulador_escritas_memoria_total"u8, "Escritas na RAM observadas pela CPU."u8, m.MemoryWrites);
+            Contador("simulador_interrupcoes_atendidas_total"u8, "Interrupções atendidas pela CPU."u8, m.InterruptsHandled);
+            Contador("simulador_interrupcoes_retornadas_total"u8, "Retornos de rotinas de interrupção."u8, m.InterruptsReturned);
+
+            var c = sim.Cache;
+            ulong reads = c.Reads, writes = c.Writes, hits = c.Hits;
+            Contador("simulador_cache_leituras_total"u8, "Leituras na cache L1."u8, reads);
+            Contador("simulador_cache_escritas_total"u8, "Escritas na cache L1."u8, writes);
+            Contador("simulador_cache_hits_total"u8, "Hits na cache L1."u8, hits);
+            Contador("simulador_cache_misses_total"u8, "Misses na cache L1."u8, c.Misses);
+            Contador("simulador_cache_escritas_memoria_total"u8, "Escritas da cache na memória principal."u8, c.MemoryWrites);
+            Medidor("simulador_cache_hit_ratio"u8, "Razão de hits acumulada (0..1)."u8, reads + writes > 0 ? (double)hits / (reads + writes) : 0);
+            Medidor("simulador_cache_tamanho_bytes"u8, "Tamanho configurado da cache L1."u8, c.CacheSizeBytes);
+
+            var d = sim.Dma;
+            Contador("simulador_dma_bytes_total"u8, "Bytes transferidos por DMA."u8, d.TotalBytesTransferidos);
+            Medidor("simulador_dma_em_execucao"u8, "1 se há transferência DMA em andamento."u8, d.EmExecucao ? 1 : 0);
+            Medidor("simulador_dma_transferencia_bytes"u8, "Progresso da transferência DMA atual (bytes)."u8, d.BytesTransferidos);
+
+            var p = engine.Desempenho;
+            Medidor("simulador_motor_ciclos_por_segundo"u8, "Ciclos simulados por segundo (última amostra)."u8, p.CiclosPorSegundo.Ultimo);
+            Medidor("simulador_motor_ns_por_ciclo"u8, "Tempo de host por ciclo simulado em ns (última amostra)."u8, p.NsPorCiclo.Ultimo);
+            Medidor("simulador_motor_instrucoes_por_segundo"u8, "Instruções por segundo (última amostra)."u8, p.InstrucoesPorSegundo.Ultimo);
+            Medidor("simulador_motor_em_execucao"u8, "1 se a thread de simulação está ativa."u8, engine.EmExecucao ? 1 : 0);
+            Contador("simulador_eventos_disparados_total"u8, "Eventos agendados disparados."u8, engine.Scheduler.EventosDisparados);
+            Contador("simulador_timer_estouros_total"u8, "Estouros do timer periódico."u8, engine.Timer.EventosGerados);
+
+            return pos;
+        }
+
+        void Contador(ReadOnlySpan<byte> nome, ReadOnlySpan<byte> ajuda, long valor)
+        {
+            Cabecalho(nome, ajuda, "counter"u8);
+            int n;
+            while (!Utf8Formatter.TryFormat(valor, Livre, out n)) Crescer();
+            pos += n;
+            Escrever("\n"u8);
+        }
+
+        void Contador(ReadOnlySpan<byte> nome, ReadOnlySpan<byte> ajuda, ulong valor)
+        {
+            Cabecalho(nome, ajuda, "counter"u8);
+            int n;
+            while (!Utf8Formatter.TryFormat(valor, Livre, out n)) Crescer();
+            pos += n;
+            Escrever("\n"u8);
+        }
+
+        void Medidor(ReadOnlySpan<byte> nome, ReadOnlySpan<byte> ajuda, double valor)
+        {
+            Cabecalho(nome, ajuda, "gauge"u8);
+            // o formato de exposição usa NaN, +Inf e -Inf
+            if (double.IsNaN(valor)) Escrever("NaN"u8);
+            else if (double.IsPositiveInfinity(valor)) Escrever("+Inf"u8);
+            else if (double.IsNegativeInfinity(valor)) Escrever("-Inf"u8);
+            else
+            {
+                int n;
+                while (!Utf8Formatter.TryFormat(valor, Livre, out n)) Crescer();
+                pos += n;
+            }
+            Escrever("\n"u8);
+        }
+
+        // "# HELP nome ajuda\n# TYPE nome tipo\nnome "
+        void Cabecalho(ReadOnlySpan<byte> nome, ReadOnlySpan<byte> ajuda, ReadOnlySpan<byte> tipo)
+        {
+            Escrever("# HELP "u8); Escrever(nome); Escrever(" "u8); Escrever(ajuda); Escrever("\n"u8);
+            Escrever("# TYPE "u8); Escrever(nome); Escrever(" "u8); Escrever(tipo); Escrever("\n"u8);
+            Escrever(nome); Escrever(" "u8);
+        }
+
+        Span<byte> Livre => buffer.AsSpan(pos);
+
+        void Escrever(ReadOnlySpan<byte> texto)
+        {
+            while (texto.Length > buffer.Length - pos) Crescer();
+            texto.CopyTo(buffer.AsSpan(pos));
+            pos += texto.Length;
+        }
+
+        // só ocorre se novas métricas excederem o buffer inicial; o buffer maior é mantido
+        void Crescer() => Array.Resize(ref buffer, buffer.Length * 2);
+    }
+}
@@ -0,0 +1,417 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Máquina isolada de uma sessão: estado, motor e cache de snapshots próprios.
+    /// </summary>
+    public sealed class SessaoSimulacao : IDisposable
+    {
+        long ultimoAcesso;
+        int execucoes;
+        // 1 quando o pool reservou a sessão para descarte: novas execuções são recusadas
+        int removendo;
+
+        // modo automático conduzido pelo pool (ver PoolSessoes.IniciarAuto)
+        internal readonly object autoSync = new();
+        internal CancellationTokenSource? auto;
+        internal Task? tarefaAuto;
+
+        internal SessaoSimulacao(string id, Configuracoes config, int ramMB)
+        {
+            Id = id;
+            State = new SimulationState { Config = config.Clone(), Ram = new RAM.RamState(ramMB) };
+            Engine = new SimulationEngine(State);
+            Snapshots = new SnapshotService(State);
+            CriadaEm = DateTime.UtcNow;
+            BytesEstimados = EstimarBytes(State);
+            Tocar();
+        }
+
+        public string Id { get; }
+        public SimulationState State { get; }
+        public SimulationEngine Engine { get; }
+        public SnapshotService Snapshots { get; }
+        public DateTime CriadaEm { get; }
+
+        /// <summary>
+        /// Memória estimada da máquina (RAM simulada + cache + custo fixo do motor).
+        /// </summary>
+        public long BytesEstimados { get; }
+
+        /// <summary>
+        /// Tempo desde o último uso (API ou execução).
+        /// </summary>
+        public TimeSpan Ociosa => Stopwatch.GetElapsedTime(Volatile.Read(ref ultimoAcesso));
+
+        /// <summary>
+        /// Verdadeiro enquanto houver execução agendada ou o modo automático estiver ativo.
+        /// </summary>
+        public bool Ocupada => Volatile.Read(ref execucoes) > 0 || AutoAtivo || Engine.EmExecucao;
+
+        /// <summary>Modo automático em andamento (conduzido pelo pool), ou null.</summary>
+        public ModoExecucao? ModoAuto { get; internal set; }
+
+        public bool AutoAtivo => ModoAuto is not null;
+
+        /// <summary>Ritmo do modo relógio automático (null nos demais modos).</summary>
+        public PacingStatus? StatusRelogio { get; internal set; }
+
+        /// <summary>Falha que encerrou o último modo automático, ou null.</summary>
+        public string? ErroAuto { get; internal set; }
+
+        public void Tocar() => Volatile.Write(ref ultimoAcesso, Stopwatch.GetTimestamp());
+
+        /// <summary>
+        /// Registra uma execução; falso se a sessão já foi reservada para descarte. Junto com
+        /// <see cref="TentarReservarRemocao"/> (ambos com barreira completa), garante que uma
+        /// execução e um descarte nunca se sobreponham.
+        /// </summary>
+        internal bool TentarEntrarExecucao()
+        {
+            Interlocked.Increment(ref execucoes);
+            if (Volatile.Read(ref removendo) == 0) return true;
+            Interlocked.Decrement(ref execucoes);
+            return false;
+        }
+
+        internal void SairExecucao() => Interlocked.Decrement(ref execucoes);
+
+        /// <summary>
+        /// Reserva a sessão para descarte se estiver livre; desiste (e libera a reserva) se houver
+        /// execução registrada ou modo automático ativo.
+        /// </summary>
+        internal bool TentarReservarRemocao()
+        {
+            if (Interlocked.CompareExchange(ref removendo, 1, 0) != 0) return false;
+            if (Volatile.Read(ref execucoes) == 0 && !AutoAtivo && !Engine.EmExecucao) return true;
+            Volatile.Write(ref removendo, 0);
+            return false;
+        }
+
+        // remoção explícita (API/fim do pool): recusa novas execuções mesmo com a sessão ocupada
+        internal void MarcarRemocao() => Volatile.Write(ref removendo, 1);
+
+        // custo fixo aproximado do motor, séries de desempenho e snapshots
+        internal const long CustoFixo = 256 * 1024;
+
+        static long EstimarBytes(SimulationState state) =>
+            state.Ram.TamanhoEmBytes + (long)state.Cache.CacheSizeBytes * 2 + CustoFixo;
+
+        public void Dispose()
+        {
+            PoolSessoes.PararAuto(this);
+            Engine.Dispose();
+        }
+    }
+
+    /// <summary>
+    /// Limites do pool de sessões.
+    /// </summary>
+    public class OpcoesPoolSessoes
+    {
+        /// <summary>Orçamento total de memória estimada das máquinas.</summary>
+        public long OrcamentoBytes { get; set; } = 1024L * 1024 * 1024;
+
+        /// <summary>Sessões ociosas por mais que isto são descartadas.</summary>
+        public TimeSpan TempoOcioso { get; set; } = TimeSpan.FromMinutes(15);
+
+        /// <summary>Execuções simultâneas (quanta de CPU do host) entre todas as sessões.</summary>
+        public int Trabalhadores { get; set; } = Environment.ProcessorCount;
+
+        /// <summary>Ciclos por quantum: cada sessão devolve o trabalhador ao fim de cada quantum.</summary>
+        public long CiclosPorQuantum { get; set; } = 262_144;
+
+        /// <summary>RAM padrão de uma sessão nova (MB).</summary>
+        public int RamPadraoMB { get; set; } = 1;
+    }
+
+    /// <summary>
+    /// Resumo de uma sessão para listagem.
+    /// </summary>
+    public record ResumoSessao(string Id, DateTime CriadaEm, double OciosaSegundos, bool Ocupada, long BytesEstimados, long CicloAtual);
+
+    /// <summary>
+    /// Pool de máquinas isoladas por sessão: criadas sob demanda, descartadas quando ociosas
+    /// e limitadas por um orçamento de memória (ao esgotar, as sessões ociosas menos
+    /// recentemente usadas são descartadas antes de recusar uma nova).
+    /// Execuções em lote de todas as sessões passam por um conjunto limitado de trabalhadores,
+    /// em quanta de <see cref="OpcoesPoolSessoes.CiclosPorQuantum"/> ciclos com fila FIFO,
+    /// para que centenas de sessões dividam o host de forma justa.
+    /// </summary>
+    public sealed class PoolSessoes : IDisposable
+    {
+        readonly ConcurrentDictionary<string, SessaoSimulacao> sessoes = new();
+        readonly object orcamentoSync = new();
+        readonly SemaphoreSlim trabalhadores;
+        readonly Timer limpeza;
+        long bytesEmUso;
+
+        public PoolSessoes(OpcoesPoolSessoes? opcoes = null)
+        {
+            Opcoes = opcoes ?? new OpcoesPoolSessoes();
+            if (Opcoes.Trabalhadores <= 0) throw new ArgumentOutOfRangeException(nameof(opcoes), "Trabalhadores deve ser positivo.");
+            if (Opcoes.CiclosPorQuantum <= 0) throw new ArgumentOutOfRangeException(nameof(opcoes), "CiclosPorQuantum deve ser positivo.");
+
+            trabalhadores = new SemaphoreSlim(Opcoes.Trabalhadores, Opcoes.Trabalhadores);
+            var intervalo = TimeSpan.FromSeconds(Math.Clamp(Opcoes.TempoOcioso.TotalSeconds / 4, 1, 60));
+            limpeza = new Timer(_ => DescartarOciosas(), null, intervalo, intervalo);
+        }
+
+        /// <summary>
+        /// RAM máxima de uma sessão (MB).
+        /// </summary>
+        public const int MaxRamMB = 64;
+
+        public OpcoesPoolSessoes Opcoes { get; }
+
+        public int Quantidade => sessoes.Count;
+
+        public long BytesEmUso => Interlocked.Read(ref bytesEmUso);
+
+        /// <summary>
+        /// Cria uma sessão nova. Lança <see cref="InvalidOperationException"/> se o orçamento
+        /// de memória não comportar a máquina mesmo após descartar sessões ociosas.
+        /// </summary>
+        public SessaoSimulacao Criar(Configuracoes? config = null, int? ramMB = null)
+        {
+            var cfg = config ?? new Configuracoes();
+            cfg.Validate();
+            int mb = ramMB ?? Opcoes.RamPadraoMB;
+            if (mb <= 0 || mb > MaxRamMB) throw new ArgumentOutOfRangeException(nameof(ramMB), $"RAM deve estar entre 1 e {MaxRamMB} MB.");
+
+            lock (orcamentoSync)
+            {
+                // estimativa prévia (sem a cache, que é pequena); o valor exato vem da sessão criada
+                long necessario = mb * 1024L * 1024 + SessaoSimulacao.CustoFixo;
+                LiberarOrcamento(necessario);
+                if (bytesEmUso + necessario > Opcoes.OrcamentoBytes)
+                    throw new InvalidOperationException("Orçamento de memória do pool esgotado.");
+
+                var sessao = new SessaoSimulacao(Guid.NewGuid().ToString("N"), cfg, mb);
+                sessoes[sessao.Id] = sessao;
+                Interlocked.Add(ref bytesEmUso, sessao.BytesEstimados);
+                return sessao;
+            }
+        }
+
+        /// <summary>
+        /// Sessão existente (marcada como usada agora), ou null.
+        /// </summary>
+        public SessaoSimulacao? Obter(string id)
+        {
+            if (!sessoes.TryGetValue(id, out var sessao)) return null;
+            sessao.Tocar();
+            return sessao;
+        }
+
+        public bool Remover(string id)
+        {
+            if (!sessoes.TryGetValue(id, out var sessao)) return false;
+            sessao.MarcarRemocao();
+            return Descartar(sessao);
+        }
+
+        // descarte automático: só se a sessão puder ser reservada (nenhuma execução em andamento)
+        bool RemoverSeLivre(SessaoSimulacao sessao) => sessao.TentarReservarRemocao() && Descartar(sessao);
+
+        bool Descartar(SessaoSimulacao sessao)
+        {
+            if (!sessoes.TryRemove(new KeyValuePair<string, SessaoSimulacao>(sessao.Id, sessao))) return false;
+            Interlocked.Add(ref bytesEmUso, -sessao.BytesEstimados);
+            sessao.Dispose();
+            return true;
+        }
+
+        public IReadOnlyList<ResumoSessao> Listar() =>
+            sessoes.Values
+                .Select(s => new ResumoSessao(s.Id, s.CriadaEm, s.Ociosa.TotalSeconds, s.Ocupada, s.BytesEstimados, s.State.CicloAtual))
+                .ToList();
+
+        /// <summary>
+        /// Executa <paramref name="ciclos"/> ciclos na sessão, fatiados em quanta. Cada quantum
+        /// espera um trabalhador livre (fila FIFO) e o devolve ao terminar, intercalando as sessões.
+        /// Lança <see cref="ObjectDisposedException"/> se a sessão já foi descartada.
+        /// </summary>
+        public async Task<RunResult> ExecutarAsync(SessaoSimulacao sessao, long ciclos, CancellationToken ct = default)
+        {
+            if (ciclos < 0) throw new ArgumentOutOfRangeException(nameof(ciclos));
+
+            long executados = 0, instrucoes = 0;
+            var duracao = TimeSpan.Zero;
+            bool cancelado = false;
+
+            if (!sessao.TentarEntrarExecucao()) throw new ObjectDisposedException(nameof(SessaoSimulacao), "Sessão encerrada.");
+            try
+            {
+                while (executados < ciclos)
+                {
+                    try
+                    {
+                        await trabalhadores.WaitAsync(ct).ConfigureAwait(false);
+                    }
+                    catch (OperationCanceledException)
+                    {
+                        cancelado = true;
+                        break;
+                    }
+
+                    RunResult parcial;
+                    try
+                    {
+                        long quantum = Math.Min(Opcoes.CiclosPorQuantum, ciclos - executados);
+                        parcial = await Task.Run(() => sessao.Engine.RunCycles(quantum, ct), CancellationToken.None).ConfigureAwait(false);
+                    }
+                    finally
+                    {
+                        trabalhadores.Release();
+                    }
+
+                    executados += parcial.CiclosExecutados;
+                    instrucoes += parcial.InstrucoesExecutadas;
+                    duracao += parcial.Duracao;
+                    sessao.Tocar();
+                    if (parcial.Cancelado) { cancelado = true; break; }
+                }
+            }
+            finally
+            {
+                sessao.SairExecucao();
+                sessao.Tocar();
+            }
+
+            return RunResult.Criar(executados, instrucoes, duracao, false, cancelado);
+        }
+
+        /// <summary>
+        /// Modo automático de uma sessão sem thread própria: a sessão executa quanta seguidos por
+        /// <see cref="ExecutarAsync"/>, disputando os mesmos trabalhadores (fila FIFO) que os lotes.
+        /// <see cref="ModoExecucao.Intervalo"/> executa um ciclo a cada <paramref name="intervalMs"/>;
+        /// <see cref="ModoExecucao.Maximo"/> encadeia quanta; <see cref="ModoExecucao.Relogio"/>
+        /// segue o ClockHz da sessão com a granularidade de um quantum. Reinicia se já estiver ativo.
+        /// </summary>
+        public void IniciarAuto(SessaoSimulacao sessao, ModoExecucao modo, int intervalMs = 1)
+        {
+            if (sessao is null) throw new ArgumentNullException(nameof(sessao));
+            lock (sessao.autoSync)
+            {
+                PararAuto(sessao);
+                var cts = new CancellationTokenSource();
+                sessao.auto = cts;
+                sessao.ModoAuto = modo;
+                sessao.StatusRelogio = null;
+                sessao.ErroAuto = null;
+                sessao.tarefaAuto = Task.Run(() => LacoAutoAsync(sessao, modo, Math.Max(1, intervalMs), cts.Token));
+            }
+        }
+
+        /// <summary>
+        /// Encerra o modo automático da sessão (aguarda o quantum em andamento).
+        /// </summary>
+        public static void PararAuto(SessaoSimulacao sessao)
+        {
+            if (sessao is null) throw new ArgumentNullException(nameof(sessao));
+            lock (sessao.autoSync)
+            {
+                var cts = sessao.auto;
+                if (cts is null) return;
+                cts.Cancel();
+                try { sessao.tarefaAuto?.Wait(); }
+                catch (AggregateException) { }
+                cts.Dispose();
+                sessao.auto = null;
+                sessao.tarefaAuto = null;
+                sessao.ModoAuto = null;
+            }
+        }
+
+        async Task LacoAutoAsync(SessaoSimulacao sessao, ModoExecucao modo, int intervalMs, CancellationToken ct)
+        {
+            ClockPacer? pacer = null;
+            if (modo == ModoExecucao.Relogio)
+            {
+                pacer = new ClockPacer(Math.Max(1, sessao.State.Config?.ClockHz ?? 100_000_000), Opcoes.CiclosPorQuantum);
+                pacer.Iniciar();
+            }
+
+            try
+            {
+                while (!ct.IsCancellationRequested)
+                {
+                    long lote;
+                    switch (modo)
+                    {
+                        case ModoExecucao.Intervalo:
+                            lote = 1;
+                            break;
+                        case ModoExecucao.Relogio:
+                            pacer!.DefinirFrequencia(Math.Max(1, sessao.State.Config?.ClockHz ?? 100_000_000));
+                            lote = pacer.ProximoLote();
+                            if (lote == 0)
+                            {
+                                // adiantado: espera sem ocupar trabalhador nem thread
+                                await Task.Delay(1, ct).ConfigureAwait(false);
+                                continue;
+                            }
+                            break;
+                        default:
+                            lote = Opcoes.CiclosPorQuantum;
+                            break;
+                    }
+
+                    var r = await ExecutarAsync(sessao, lote, ct).ConfigureAwait(false);
+                    if (pacer is not null)
+                    {
+                        pacer.Registrar(r.CiclosExecutados);
+                        sessao.StatusRelogio = pacer.ObterStatus();
+                    }
+                    if (r.Cancelado) break;
+
+                    if (modo == ModoExecucao.Intervalo) await Task.Delay(intervalMs, ct).ConfigureAwait(false);
+                }
+            }
+            catch (OperationCanceledException)
+            {
+            }
+            catch (Exception ex)
+            {
+                // falha na simulação encerra o modo automático de forma visível
+                sessao.ErroAuto = ex.Message;
+                sessao.ModoAuto = null;
+            }
+        }
+
+        // descarta ociosas (menos recentes primeiro) até caber "necessario"; chamado sob orcamentoSync
+        void LiberarOrcamento(long necessario)
+        {
+            if (bytesEmUso + necessario <= Opcoes.OrcamentoBytes) return;
+
+            foreach (var s in sessoes.Values.Where(s => !s.Ocupada).OrderByDescending(s => s.Ociosa))
+            {
+                RemoverSeLivre(s);
+                if (bytesEmUso + necessario <= Opcoes.OrcamentoBytes) return;
+            }
+        }
+
+        void DescartarOciosas()
+        {
+            foreach (var s in sessoes.Values)
+            {
+                if (!s.Ocupada && s.Ociosa > Opcoes.TempoOcioso) RemoverSeLivre(s);
+            }
+        }
+
+        public void Dispose()
+        {
+            limpeza.Dispose();
+            foreach (var id in sessoes.Keys.ToList()) Remover(id);
+            trabalhadores.Dispose();
+        }
+    }
+}
@@ -0,0 +1,174 @@
+using System;
+using System.Globalization;
+using System.IO;
+using System.Text;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Efeito de um acesso reproduzido sobre a cache (ver <see cref="ReprodutorTrace.AcessarLote"/>).
+    /// </summary>
+    [Flags]
+    public enum ResultadoAcesso : byte
+    {
+        Acerto = 0,
+        Falha = 1,
+        EscritaMemoria = 2
+    }
+
+    /// <summary>
+    /// Latências usadas na reprodução de traces, derivadas de <see cref="Configuracoes"/>:
+    /// cada instrução custa 1 ciclo; um acerto na L1 custa <c>L1HitCycles</c> e uma falha
+    /// <c>L1MissCycles</c>; cada escrita na memória principal ocupa o barramento por
+    /// ceil(bytes / <c>BusWidthBytes</c>) transferências de (1 + <c>BusWaitStates</c>) ciclos —
+    /// a linha inteira em write-back (vítima suja), só o dado em write-through.
+    /// </summary>
+    public readonly record struct ModeloTempoMemoria(
+        int CiclosInstrucao,
+        int CiclosAcerto,
+        int CiclosFalha,
+        int LarguraBarramento,
+        int CiclosPorTransferencia,
+        int BytesPorEscritaMemoria)
+    {
+        public static ModeloTempoMemoria De(Configuracoes cfg)
+        {
+            bool writeBack = !string.Equals(cfg.L1WritePolicy ?? "WT", "WT", StringComparison.OrdinalIgnoreCase);
+            return new ModeloTempoMemoria(
+                CiclosInstrucao: 1,
+                CiclosAcerto: Math.Max(0, cfg.L1HitCycles),
+                CiclosFalha: Math.Max(0, cfg.L1MissCycles),
+                LarguraBarramento: Math.Max(1, cfg.BusWidthBytes),
+                CiclosPorTransferencia: 1 + Math.Max(0, cfg.BusWaitStates),
+                BytesPorEscritaMemoria: writeBack ? Math.Max(1, cfg.L1LineSize) : 0);
+        }
+
+        /// <summary>Ciclos de barramento de uma escrita de <paramref name="tamanho"/> bytes na memória.</summary>
+        public long CiclosEscritaMemoria(int tamanho)
+        {
+            int bytes = BytesPorEscritaMemoria > 0 ? BytesPorEscritaMemoria : Math.Max(1, tamanho);
+            return (long)((bytes + LarguraBarramento - 1) / LarguraBarramento) * CiclosPorTransferencia;
+        }
+    }
+
+    /// <summary>
+    /// Resultado de <see cref="SimulationEngine.ReproduzirTrace"/>. <c>CiclosModelados</c> é o
+    /// tempo estimado pelo <see cref="ModeloTempoMemoria"/>; <c>CiclosGravados</c> é a duração
+    /// registrada no trace (null para listas de endereços).
+    /// </summary>
+    public record ResultadoReproducao(
+        long Registros,
+        long Instrucoes,
+        long Leituras,
+        long Escritas,
+        long Acertos,
+        long Falhas,
+        long EscritasMemoria,
+        long CiclosModelados,
+        long? CiclosGravados,
+        TimeSpan Duracao,
+        double RegistrosPorSegundo,
+        bool Cancelado
+    );
+
+    /// <summary>
+    /// Lista de endereços em texto, no formato de <c>CACHE/enderecos.txt</c>: um endereço por
+    /// linha, decimal ou hexadecimal (<c>0x</c>), opcionalmente precedido de <c>R</c> ou <c>W</c>
+    /// (padrão: leitura). Linhas vazias e iniciadas por <c>#</c> são ignoradas. Cada acesso é de
+    /// 4 bytes e o "ciclo" do registro é o número da linha.
+    /// </summary>
+    public sealed class LeitorEnderecos : IFonteTrace
+    {
+        readonly TextReader origem;
+        long linha;
+
+        public LeitorEnderecos(TextReader origem)
+        {
+            this.origem = origem ?? throw new ArgumentNullException(nameof(origem));
+        }
+
+        public int Ler(Span<RegistroTrace> destino)
+        {
+            int n = 0;
+            string? texto;
+            while (n < destino.Length && (texto = origem.ReadLine()) is not null)
+            {
+                linha++;
+                var campo = texto.AsSpan().Trim();
+                if (campo.IsEmpty || campo[0] == '#') continue;
+
+                var tipo = TipoRegistroTrace.Leitura;
+                if (campo[0] is 'R' or 'r' or 'W' or 'w')
+                {
+                    if (campo[0] is 'W' or 'w') tipo = TipoRegistroTrace.Escrita;
+                    campo = campo[1..].TrimStart();
+                }
+
+                bool ok = campo.StartsWith("0x", StringComparison.OrdinalIgnoreCase)
+                    ? uint.TryParse(campo[2..], NumberStyles.AllowHexSpecifier, CultureInfo.InvariantCulture, out uint endereco)
+                    : uint.TryParse(campo, NumberStyles.None, CultureInfo.InvariantCulture, out endereco);
+                if (!ok) throw new InvalidDataException($"Endereço inválido na linha {linha}: '{texto}'.");
+
+                destino[n++] = new RegistroTrace(tipo, linha, (int)endereco, 4, 0);
+            }
+            return n;
+        }
+
+        public void Dispose() => origem.Dispose();
+    }
+
+    public static class ReprodutorTrace
+    {
+        /// <summary>
+        /// Registra em <paramref name="cache"/> os acessos de <paramref name="registros"/> sem
+        /// transferir dados. Registros de instrução são ignorados. Para cada registro,
+        /// <paramref name="resultados"/> recebe se houve falha e/ou escrita na memória principal.
+        /// </summary>
+        internal static void AcessarLote(Cache.Cache cache, ReadOnlySpan<RegistroTrace> registros, Span<ResultadoAcesso> resultados)
+        {
+            for (int i = 0; i < registros.Length; i++)
+            {
+                var r = registros[i];
+                if (r.Tipo == TipoRegistroTrace.Instrucao)
+                {
+                    resultados[i] = ResultadoAcesso.Acerto;
+                    continue;
+                }
+
+                ulong falhas = cache.Misses, escritasMemoria = cache.MemoryWrites;
+                cache.Access((uint)r.Endereco, r.Tipo == TipoRegistroTrace.Escrita);
+
+                var resultado = ResultadoAcesso.Acerto;
+                if (cache.Misses != falhas) resultado |= ResultadoAcesso.Falha;
+                if (cache.MemoryWrites != escritasMemoria) resultado |= ResultadoAcesso.EscritaMemoria;
+                resultados[i] = resultado;
+            }
+        }
+
+        /// <summary>
+        /// Abre <paramref name="origem"/> como trace binário (<see cref="FormatoTrace"/>) se começar
+        /// pela assinatura, ou como lista de endereços em texto caso contrário. Streams sem
+        /// posicionamento são copiados para a memória antes da detecção.
+        /// </summary>
+        public static IFonteTrace AbrirFonte(Stream origem)
+        {
+            if (origem is null) throw new ArgumentNullException(nameof(origem));
+            if (!origem.CanSeek)
+            {
+                var copia = new MemoryStream();
+                using (origem) origem.CopyTo(copia);
+                copia.Position = 0;
+                origem = copia;
+            }
+
+            long inicio = origem.Position;
+            Span<byte> assinatura = stackalloc byte[FormatoTrace.Assinatura.Length];
+            int lidos = origem.ReadAtLeast(assinatura, assinatura.Length, throwOnEndOfStream: false);
+            origem.Position = inicio;
+
+            if (lidos == assinatura.Length && assinatura.SequenceEqual(FormatoTrace.Assinatura))
+                return new LeitorTrace(origem);
+            return new LeitorEnderecos(new StreamReader(origem, Encoding.UTF8));
+        }
+    }
+}
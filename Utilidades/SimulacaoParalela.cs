@@ -0,0 +1,408 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.IO;
+using System.Threading;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    public enum TipoMensagemDispositivo : byte
+    {
+        /// <summary>CPU → dispositivo: escrita no registrador <c>Endereco</c> com <c>Valor</c>.</summary>
+        Registro = 0,
+
+        /// <summary>Dispositivo → CPU: levanta a linha de IRQ <c>Valor</c> no PIC.</summary>
+        Irq = 1,
+
+        /// <summary>Dispositivo → CPU: grava <c>Dados</c> na RAM a partir de <c>Endereco</c>.</summary>
+        EscritaRam = 2
+    }
+
+    /// <summary>
+    /// Mensagem com carimbo de tempo trocada entre a CPU e um <see cref="DispositivoParalelo"/>.
+    /// <c>Ciclo</c> é o ciclo em que a mensagem produz efeito no destino; (Ciclo, Origem,
+    /// Sequencia) define uma ordem total, independente da thread que a produziu.
+    /// </summary>
+    public readonly record struct MensagemDispositivo(
+        long Ciclo,
+        int Origem,
+        long Sequencia,
+        TipoMensagemDispositivo Tipo,
+        int Endereco,
+        long Valor,
+        byte[]? Dados = null);
+
+    /// <summary>
+    /// Modelo de dispositivo que roda fora da thread do motor, com sua própria agenda de eventos
+    /// (<see cref="Agenda"/>, no tempo local do dispositivo). A comunicação com a CPU é feita só
+    /// por mensagens em filas sem lock, e toda mensagem produz efeito pelo menos
+    /// <see cref="LatenciaCiclos"/> ciclos depois de enviada — é essa latência mínima que permite
+    /// ao <see cref="CoordenadorDispositivos"/> simular o dispositivo em paralelo com a CPU.
+    /// </summary>
+    public abstract class DispositivoParalelo
+    {
+        // CPU → dispositivo (produtor: motor; consumidor: thread do dispositivo)
+        readonly ConcurrentQueue<MensagemDispositivo> entrada = new();
+        // dispositivo → CPU (produtor: thread do dispositivo; consumidor: motor, na barreira)
+        readonly ConcurrentQueue<MensagemDispositivo> saida = new();
+        // recebidas ainda no futuro do dispositivo, em ordem de efeito
+        readonly PriorityQueue<MensagemDispositivo, (long Ciclo, long Sequencia)> recebidas = new();
+        long sequenciaSaida;
+
+        protected DispositivoParalelo(string nome, long latenciaCiclos)
+        {
+            if (string.IsNullOrWhiteSpace(nome)) throw new ArgumentException("Nome obrigatório.", nameof(nome));
+            if (latenciaCiclos <= 0) throw new ArgumentOutOfRangeException(nameof(latenciaCiclos), "Latência deve ser positiva.");
+            Nome = nome;
+            LatenciaCiclos = latenciaCiclos;
+        }
+
+        public string Nome { get; }
+
+        /// <summary>
+        /// Latência mínima, em ciclos, entre o envio de uma mensagem (em qualquer sentido) e seu efeito.
+        /// </summary>
+        public long LatenciaCiclos { get; }
+
+        /// <summary>Posição no coordenador (origem das mensagens enviadas).</summary>
+        public int Indice { get; internal set; } = -1;
+
+        /// <summary>Até onde o dispositivo já foi simulado (exclusivo).</summary>
+        public long CicloLocal { get; private set; }
+
+        /// <summary>
+        /// Eventos internos do dispositivo, em ciclos absolutos. Só deve ser usada pelo próprio
+        /// dispositivo (dentro de <see cref="Receber"/> e dos callbacks).
+        /// </summary>
+        protected EventScheduler Agenda { get; } = new();
+
+        /// <summary>
+        /// Trata uma mensagem da CPU; <see cref="CicloLocal"/> vale o ciclo de efeito da mensagem.
+        /// </summary>
+        protected abstract void Receber(in MensagemDispositivo mensagem);
+
+        /// <summary>
+        /// Grava o estado do dispositivo (assinatura do estado da máquina).
+        /// </summary>
+        public abstract void SalvarEstado(BinaryWriter w);
+
+        /// <summary>
+        /// Texto curto para a UI/API. Chamado com o dispositivo parado.
+        /// </summary>
+        public virtual string Resumo() => string.Empty;
+
+        protected void EnviarIrq(int linha) =>
+            Enviar(TipoMensagemDispositivo.Irq, 0, linha, null);
+
+        protected void EnviarEscritaRam(int endereco, byte[] dados) =>
+            Enviar(TipoMensagemDispositivo.EscritaRam, endereco, 0, (byte[])(dados ?? throw new ArgumentNullException(nameof(dados))).Clone());
+
+        void Enviar(TipoMensagemDispositivo tipo, int endereco, long valor, byte[]? dados) =>
+            saida.Enqueue(new MensagemDispositivo(CicloLocal + LatenciaCiclos, Indice, sequenciaSaida++, tipo, endereco, valor, dados));
+
+        internal void Posicionar(long ciclo) => CicloLocal = ciclo;
+
+        internal void Entregar(in MensagemDispositivo mensagem) => entrada.Enqueue(mensagem);
+
+        /// <summary>
+        /// Simula até <paramref name="ate"/> (exclusivo), intercalando em ordem de ciclo as
+        /// mensagens recebidas e os eventos da agenda (mensagens primeiro em caso de empate).
+        /// </summary>
+        internal void AvancarAte(long ate)
+        {
+            if (ate <= CicloLocal) return;
+
+            while (entrada.TryDequeue(out var m)) recebidas.Enqueue(m, (m.Ciclo, m.Sequencia));
+
+            while (true)
+            {
+                long proximaMensagem = recebidas.TryPeek(out var m, out _) ? m.Ciclo : long.MaxValue;
+                long proximo = Math.Min(proximaMensagem, Agenda.ProximoCiclo);
+                if (proximo >= ate) break;
+
+                CicloLocal = Math.Max(CicloLocal, proximo);
+                if (proximaMensagem <= Agenda.ProximoCiclo)
+                {
+                    recebidas.Dequeue();
+                    Receber(m);
+                }
+                else
+                {
+                    Agenda.ExecutarVencidos(CicloLocal);
+                }
+            }
+
+            CicloLocal = ate;
+        }
+
+        internal void ColetarSaida(List<MensagemDispositivo> destino)
+        {
+            while (saida.TryDequeue(out var m)) destino.Add(m);
+        }
+
+        // mensagens da CPU ainda não processadas, em ordem (com o dispositivo parado)
+        internal void SalvarPendentes(BinaryWriter w)
+        {
+            while (entrada.TryDequeue(out var m)) recebidas.Enqueue(m, (m.Ciclo, m.Sequencia));
+            var ordenadas = new List<MensagemDispositivo>(recebidas.UnorderedItems.Count);
+            foreach (var (m, _) in recebidas.UnorderedItems) ordenadas.Add(m);
+            ordenadas.Sort(CoordenadorDispositivos.Comparar);
+            w.Write(CicloLocal);
+            CoordenadorDispositivos.Escrever(w, ordenadas);
+        }
+    }
+
+    /// <summary>
+    /// Sincronização conservadora entre a CPU (thread do motor) e os dispositivos paralelos.
+    /// O tempo é dividido em janelas de L ciclos, L = menor latência entre os dispositivos:
+    /// enquanto a CPU executa a janela [t, t+L), cada dispositivo simula a mesma janela na sua
+    /// thread. Como toda mensagem gerada dentro da janela só vale a partir de t+L, nenhum lado
+    /// precisa do outro até a barreira no fim da janela, onde as saídas dos dispositivos são
+    /// recolhidas e ordenadas por (ciclo, origem, sequência). O resultado não depende do
+    /// escalonamento das threads, nem de <see cref="Paralelo"/>: sem paralelismo, os dispositivos
+    /// simulam a janela na própria thread do motor, na mesma ordem.
+    /// Os métodos internos são chamados com o bloqueio de execução do motor adquirido.
+    /// </summary>
+    public sealed class CoordenadorDispositivos : IDisposable
+    {
+        readonly List<DispositivoParalelo> dispositivos = new();
+        readonly List<Hospede> hospedes = new();
+        readonly PriorityQueue<MensagemDispositivo, (long, int, long)> pendentes = new();
+        readonly List<MensagemDispositivo> coletadas = new();
+        CountdownEvent? concluidos;
+        bool emJanela;
+        long janelaFim = long.MaxValue;
+        long sequenciaEntrada;
+        bool paralelo;
+
+        public CoordenadorDispositivos(bool paralelo)
+        {
+            this.paralelo = paralelo;
+        }
+
+        /// <summary>
+        /// Se verdadeiro, cada dispositivo roda numa thread dedicada do host. Só pode mudar
+        /// antes do primeiro dispositivo ser registrado.
+        /// </summary>
+        public bool Paralelo
+        {
+            get => paralelo;
+            set
+            {
+                if (dispositivos.Count > 0) throw new InvalidOperationException("Dispositivos já registrados.");
+                paralelo = value;
+            }
+        }
+
+        public IReadOnlyList<DispositivoParalelo> Dispositivos => dispositivos;
+
+        /// <summary>Tamanho da janela (menor latência), ou 0 sem dispositivos.</summary>
+        public long Janela { get; private set; }
+
+        /// <summary>Barreiras de fim de janela já atravessadas.</summary>
+        public long Barreiras { get; private set; }
+
+        /// <summary>
+        /// Próximo ciclo em que a CPU precisa parar para o coordenador: fim da janela ou entrega
+        /// de uma mensagem pendente.
+        /// </summary>
+        internal long ProximoLimite =>
+            Math.Min(janelaFim, pendentes.TryPeek(out var m, out _) ? m.Ciclo : long.MaxValue);
+
+        internal void Adicionar(DispositivoParalelo dispositivo, long cicloAtual)
+        {
+            if (dispositivo.Indice >= 0) throw new InvalidOperationException("Dispositivo já registrado.");
+            Aguardar();
+
+            dispositivo.Indice = dispositivos.Count;
+            dispositivo.Posicionar(cicloAtual);
+            dispositivos.Add(dispositivo);
+            Janela = Janela == 0 ? dispositivo.LatenciaCiclos : Math.Min(Janela, dispositivo.LatenciaCiclos);
+
+            // janelas recomeçam do ciclo atual com o novo tamanho
+            janelaFim = cicloAtual;
+            if (Paralelo)
+            {
+                concluidos ??= new CountdownEvent(0);
+                hospedes.Add(new Hospede(dispositivo, this));
+            }
+        }
+
+        /// <summary>
+        /// Mensagem da CPU para <paramref name="dispositivo"/>, com efeito em
+        /// <paramref name="cicloAtual"/> + latência do dispositivo.
+        /// </summary>
+        internal void Enviar(DispositivoParalelo dispositivo, long cicloAtual, int registro, long valor)
+        {
+            dispositivo.Entregar(new MensagemDispositivo(cicloAtual + dispositivo.LatenciaCiclos, -1,
+                sequenciaEntrada++, TipoMensagemDispositivo.Registro, registro, valor));
+        }
+
+        /// <summary>
+        /// Chamado pela CPU no ciclo <paramref name="ciclo"/>: atravessa a barreira se a janela
+        /// acabou (iniciando a seguinte) e aplica as mensagens vencidas, em ordem.
+        /// </summary>
+        internal void Sincronizar(long ciclo, Action<MensagemDispositivo> aplicar)
+        {
+            if (dispositivos.Count == 0) return;
+
+            if (ciclo >= janelaFim)
+            {
+                Aguardar();
+                long inicio = janelaFim;
+                janelaFim = inicio + Janela;
+                IniciarJanela(janelaFim);
+                Barreiras++;
+            }
+
+            while (pendentes.TryPeek(out var m, out _) && m.Ciclo <= ciclo)
+            {
+                pendentes.Dequeue();
+                aplicar(m);
+            }
+        }
+
+        /// <summary>
+        /// Aguarda a janela em andamento e recolhe suas saídas (fim de lote, leitura de estado).
+        /// Relança a primeira exceção de um dispositivo.
+        /// </summary>
+        internal void Aguardar()
+        {
+            if (!emJanela) return;
+            emJanela = false;
+
+            if (Paralelo) concluidos!.Wait();
+
+            Exception? falha = null;
+            foreach (var h in hospedes)
+            {
+                falha ??= h.Falha;
+                h.Falha = null;
+            }
+
+            foreach (var d in dispositivos) d.ColetarSaida(coletadas);
+            foreach (var m in coletadas) pendentes.Enqueue(m, (m.Ciclo, m.Origem, m.Sequencia));
+            coletadas.Clear();
+
+            if (falha is not null) throw new InvalidOperationException("Falha em dispositivo paralelo.", falha);
+        }
+
+        void IniciarJanela(long ate)
+        {
+            emJanela = true;
+            if (!Paralelo)
+            {
+                foreach (var d in dispositivos) d.AvancarAte(ate);
+                return;
+            }
+
+            concluidos!.Reset(hospedes.Count);
+            foreach (var h in hospedes) h.Iniciar(ate);
+        }
+
+        /// <summary>
+        /// Estado dos dispositivos e das mensagens em trânsito (com a janela concluída).
+        /// </summary>
+        internal void SalvarEstado(BinaryWriter w)
+        {
+            Aguardar();
+            w.Write(dispositivos.Count);
+            w.Write(janelaFim);
+            foreach (var d in dispositivos)
+            {
+                w.Write(d.Nome);
+                d.SalvarPendentes(w);
+                d.SalvarEstado(w);
+            }
+
+            var ordenadas = new List<MensagemDispositivo>(pendentes.UnorderedItems.Count);
+            foreach (var (m, _) in pendentes.UnorderedItems) ordenadas.Add(m);
+            ordenadas.Sort(Comparar);
+            Escrever(w, ordenadas);
+        }
+
+        internal static int Comparar(MensagemDispositivo a, MensagemDispositivo b)
+        {
+            int c = a.Ciclo.CompareTo(b.Ciclo);
+            if (c == 0) c = a.Origem.CompareTo(b.Origem);
+            return c != 0 ? c : a.Sequencia.CompareTo(b.Sequencia);
+        }
+
+        internal static void Escrever(BinaryWriter w, List<MensagemDispositivo> mensagens)
+        {
+            w.Write(mensagens.Count);
+            foreach (var m in mensagens)
+            {
+                w.Write(m.Ciclo);
+                w.Write(m.Origem);
+                w.Write(m.Sequencia);
+                w.Write((byte)m.Tipo);
+                w.Write(m.Endereco);
+                w.Write(m.Valor);
+                w.Write(m.Dados?.Length ?? -1);
+                if (m.Dados is not null) w.Write(m.Dados);
+            }
+        }
+
+        public void Dispose()
+        {
+            try { Aguardar(); } catch (InvalidOperationException) { }
+            foreach (var h in hospedes) h.Encerrar();
+            hospedes.Clear();
+            concluidos?.Dispose();
+        }
+
+        // thread dedicada de um dispositivo: simula uma janela por sinal recebido
+        sealed class Hospede
+        {
+            readonly DispositivoParalelo dispositivo;
+            readonly CoordenadorDispositivos coordenador;
+            readonly SemaphoreSlim sinal = new(0);
+            readonly Thread thread;
+            long alvo;
+            volatile bool encerrar;
+
+            public Exception? Falha;
+
+            public Hospede(DispositivoParalelo dispositivo, CoordenadorDispositivos coordenador)
+            {
+                this.dispositivo = dispositivo;
+                this.coordenador = coordenador;
+                thread = new Thread(Laco) { IsBackground = true, Name = "Dispositivo " + dispositivo.Nome };
+                thread.Start();
+            }
+
+            public void Iniciar(long ate)
+            {
+                alvo = ate;
+                sinal.Release();
+            }
+
+            public void Encerrar()
+            {
+                encerrar = true;
+                sinal.Release();
+                thread.Join();
+                sinal.Dispose();
+            }
+
+            void Laco()
+            {
+                while (true)
+                {
+                    sinal.Wait();
+                    if (encerrar) return;
+                    try
+                    {
+                        dispositivo.AvancarAte(alvo);
+                    }
+                    catch (Exception ex)
+                    {
+                        Falha = ex;
+                    }
+                    coordenador.concluidos!.Signal();
+                }
+            }
+        }
+    }
+}
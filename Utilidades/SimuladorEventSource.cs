@@ -0,0 +1,174 @@
+using System;
+using System.Diagnostics.Tracing;
+using System.Threading;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Instrumentação do simulador para <c>dotnet-counters</c> / <c>dotnet-trace</c>
+    /// (provider <c>ProjetoSimuladorPC.Simulador</c>).
+    /// Contadores: taxas de ciclos, instruções, hits/misses da cache, bytes lidos/escritos na RAM,
+    /// bytes de DMA, IRQs levantadas/reconhecidas e tempo de construção de snapshots.
+    /// Eventos de trace (nível Verbose) marcam as fronteiras de fase do motor.
+    /// Sem ouvinte conectado, cada ponto de instrumentação custa apenas a checagem de <see cref="EventSource.IsEnabled()"/>.
+    /// Os totais são do processo: várias instâncias do motor (ex.: varreduras) somam nos mesmos contadores.
+    /// </summary>
+    [EventSource(Name = "ProjetoSimuladorPC.Simulador")]
+    public sealed class SimuladorEventSource : EventSource
+    {
+        public static readonly SimuladorEventSource Log = new();
+
+        public static class Keywords
+        {
+            /// <summary>Fases do motor (lotes, publicação, reconfiguração).</summary>
+            public const EventKeywords Motor = (EventKeywords)0x1;
+            /// <summary>Disparos de eventos agendados (volume alto).</summary>
+            public const EventKeywords Eventos = (EventKeywords)0x2;
+        }
+
+        long ciclos;
+        long instrucoes;
+        long hitsCache;
+        long missesCache;
+        long bytesLidosRam;
+        long bytesEscritosRam;
+        long bytesDma;
+        long irqsLevantadas;
+        long irqsReconhecidas;
+
+        IncrementingPollingCounter? ciclosPorSegundo;
+        IncrementingPollingCounter? instrucoesPorSegundo;
+        IncrementingPollingCounter? hitsPorSegundo;
+        IncrementingPollingCounter? missesPorSegundo;
+        IncrementingPollingCounter? ramLidosPorSegundo;
+        IncrementingPollingCounter? ramEscritosPorSegundo;
+        IncrementingPollingCounter? dmaPorSegundo;
+        IncrementingPollingCounter? irqsLevantadasPorSegundo;
+        IncrementingPollingCounter? irqsReconhecidasPorSegundo;
+        EventCounter? tempoSnapshot;
+
+        SimuladorEventSource() { }
+
+        protected override void OnEventCommand(EventCommandEventArgs command)
+        {
+            if (command.Command != EventCommand.Enable || ciclosPorSegundo is not null) return;
+
+            var porSegundo = TimeSpan.FromSeconds(1);
+            ciclosPorSegundo = new IncrementingPollingCounter("ciclos-por-segundo", this, () => Interlocked.Read(ref ciclos))
+                { DisplayName = "Ciclos simulados", DisplayRateTimeScale = porSegundo };
+            instrucoesPorSegundo = new IncrementingPollingCounter("instrucoes-por-segundo", this, () => Interlocked.Read(ref instrucoes))
+                { DisplayName = "Instruções executadas", DisplayRateTimeScale = porSegundo };
+            hitsPorSegundo = new IncrementingPollingCounter("cache-hits", this, () => Interlocked.Read(ref hitsCache))
+                { DisplayName = "Hits da cache", DisplayRateTimeScale = porSegundo };
+            missesPorSegundo = new IncrementingPollingCounter("cache-misses", this, () => Interlocked.Read(ref missesCache))
+                { DisplayName = "Misses da cache", DisplayRateTimeScale = porSegundo };
+            ramLidosPorSegundo = new IncrementingPollingCounter("ram-bytes-lidos", this, () => Interlocked.Read(ref bytesLidosRam))
+                { DisplayName = "Bytes lidos da RAM", DisplayUnits = "B", DisplayRateTimeScale = porSegundo };
+            ramEscritosPorSegundo = new IncrementingPollingCounter("ram-bytes-escritos", this, () => Interlocked.Read(ref bytesEscritosRam))
+                { DisplayName = "Bytes escritos na RAM", DisplayUnits = "B", DisplayRateTimeScale = porSegundo };
+            dmaPorSegundo = new IncrementingPollingCounter("dma-bytes", this, () => Interlocked.Read(ref bytesDma))
+                { DisplayName = "Bytes transferidos por DMA", DisplayUnits = "B", DisplayRateTimeScale = porSegundo };
+            irqsLevantadasPorSegundo = new IncrementingPollingCounter("irqs-levantadas", this, () => Interlocked.Read(ref irqsLevantadas))
+                { DisplayName = "IRQs levantadas", DisplayRateTimeScale = porSegundo };
+            irqsReconhecidasPorSegundo = new IncrementingPollingCounter("irqs-reconhecidas", this, () => Interlocked.Read(ref irqsReconhecidas))
+                { DisplayName = "IRQs reconhecidas", DisplayRateTimeScale = porSegundo };
+            tempoSnapshot = new EventCounter("tempo-snapshot", this)
+                { DisplayName = "Tempo de construção do snapshot", DisplayUnits = "ms" };
+        }
+
+        // --- contadores (chamados pelos módulos; sem ouvinte, retornam após a checagem) ---
+
+        [NonEvent]
+        public void CiclosExecutados(long ciclosLote, long instrucoesLote, long hits, long misses)
+        {
+            if (!IsEnabled()) return;
+            Interlocked.Add(ref ciclos, ciclosLote);
+            Interlocked.Add(ref instrucoes, instrucoesLote);
+            Interlocked.Add(ref hitsCache, hits);
+            Interlocked.Add(ref missesCache, misses);
+        }
+
+        [NonEvent]
+        public void RamLida(int bytes)
+        {
+            if (IsEnabled()) Interlocked.Add(ref bytesLidosRam, bytes);
+        }
+
+        [NonEvent]
+        public void RamEscrita(int bytes)
+        {
+            if (IsEnabled()) Interlocked.Add(ref bytesEscritosRam, bytes);
+        }
+
+        [NonEvent]
+        public void DmaTransferiu(long bytes)
+        {
+            if (IsEnabled()) Interlocked.Add(ref bytesDma, bytes);
+        }
+
+        [NonEvent]
+        public void IrqLevantada()
+        {
+            if (IsEnabled()) Interlocked.Increment(ref irqsLevantadas);
+        }
+
+        [NonEvent]
+        public void IrqReconhecida()
+        {
+            if (IsEnabled()) Interlocked.Increment(ref irqsReconhecidas);
+        }
+
+        [NonEvent]
+        public void SnapshotConstruido(double milissegundos) => tempoSnapshot?.WriteMetric(milissegundos);
+
+        // --- eventos de trace nas fronteiras de fase do motor ---
+
+        [Event(1, Level = EventLevel.Verbose, Keywords = Keywords.Motor, Message = "Lote iniciado no ciclo {0} ({1} ciclos)")]
+        public void LoteInicio(long ciclo, long quantidade)
+        {
+            if (IsEnabled(EventLevel.Verbose, Keywords.Motor)) WriteEvent(1, ciclo, quantidade);
+        }
+
+        [Event(2, Level = EventLevel.Verbose, Keywords = Keywords.Motor, Message = "Lote encerrado no ciclo {0} ({1} ciclos executados)")]
+        public void LoteFim(long ciclo, long executados)
+        {
+            if (IsEnabled(EventLevel.Verbose, Keywords.Motor)) WriteEvent(2, ciclo, executados);
+        }
+
+        [Event(3, Level = EventLevel.Verbose, Keywords = Keywords.Motor, Message = "Snapshot publicado (versão {0})")]
+        public void SnapshotPublicado(long versao)
+        {
+            if (IsEnabled(EventLevel.Verbose, Keywords.Motor)) WriteEvent(3, versao);
+        }
+
+        [Event(4, Level = EventLevel.Informational, Keywords = Keywords.Motor, Message = "Thread de simulação iniciada: {0}")]
+        public void ExecucaoIniciada(string modo)
+        {
+            if (IsEnabled(EventLevel.Informational, Keywords.Motor)) WriteEvent(4, modo);
+        }
+
+        [Event(5, Level = EventLevel.Informational, Keywords = Keywords.Motor, Message = "Thread de simulação encerrada após {0} ciclos")]
+        public void ExecucaoEncerrada(long ciclos)
+        {
+            if (IsEnabled(EventLevel.Informational, Keywords.Motor)) WriteEvent(5, ciclos);
+        }
+
+        [Event(6, Level = EventLevel.Informational, Keywords = Keywords.Motor, Message = "Reconfiguração aplicada (cache={0}, mmio={1}, timer={2})")]
+        public void Reconfigurado(bool cache, bool mmio, bool timer)
+        {
+            if (IsEnabled(EventLevel.Informational, Keywords.Motor)) WriteEvent(6, cache, mmio, timer);
+        }
+
+        [Event(7, Level = EventLevel.Verbose, Keywords = Keywords.Eventos, Message = "Eventos agendados disparados no ciclo {0}: {1}")]
+        public void EventosDisparados(long ciclo, long quantidade)
+        {
+            if (IsEnabled(EventLevel.Verbose, Keywords.Eventos)) WriteEvent(7, ciclo, quantidade);
+        }
+
+        [Event(8, Level = EventLevel.Error, Keywords = Keywords.Motor, Message = "Thread de simulação interrompida por falha no ciclo {0}: {1}")]
+        public void ExecucaoFalhou(long ciclo, string erro)
+        {
+            if (IsEnabled(EventLevel.Error, Keywords.Motor)) WriteEvent(8, ciclo, erro);
+        }
+    }
+}
@@ -1,5 +1,11 @@
 ﻿using System;
+using System.ComponentModel.DataAnnotations;
+using System.Diagnostics;
 using System.Globalization;
+using System.IO;
+using System.Security.Cryptography;
+using System.Text;
+using System.Text.Json;
 using System.Threading;
 using System.Threading.Tasks;
 using ProjetoSimIO.Core;
@@ -20,12 +26,55 @@ public class SimulationEngine : IDisposable
     readonly Metrics metrics;
     readonly PicController pic;
     readonly CpuSimulator cpuSimulator;
-    readonly Cache.Cache cacheSim;
-    readonly DispositivoMMIO mmio;
-    readonly DMA.DMA dmaSim;
+    // componentes reconstruíveis por Reconfigurar (trocados sob execSync)
+    Cache.Cache cacheSim;
+    DispositivoMMIO mmio;
+    DMA.DMA dmaSim;
+    Configuracoes configAtiva;
     readonly RamState ram;
     readonly DmaState dmaState;
-    System.Threading.Timer? autoTimer;
+    readonly EventScheduler scheduler = new();
+    readonly DispositivoTimer timer;
+
+    // thread dedicada do modo automático
+    Thread? simThread;
+    volatile bool pararThread;
+    readonly ManualResetEventSlim sinalParada = new(false);
+    readonly object autoSync = new();
+
+    // serializa a execução de ciclos (a fila de eventos e a CPU não são thread-safe)
+    readonly object execSync = new();
+
+    // tempo de host gasto dentro de ExecutarCiclos (ticks do Stopwatch), para ns/ciclo
+    long ticksExecucao;
+
+    // criado sob demanda (ver Desempenho): motores de varreduras, jobs e sessões não pagam o timer
+    AmostradorDesempenho? desempenho;
+    object? desempenhoSync;
+
+    // > 0 enquanto uma execução em lote (headless) está ativa: suprime notificações por acesso
+    int notificacoesSuspensas;
+
+    // depuração reversa (null = desligada) e reaplicação de entradas do histórico em curso
+    DepuradorReverso? reverso;
+    bool reproduzindoEntradas;
+
+    // trace de execução em gravação (null = desligado) e stream a fechar ao parar
+    EscritorTrace? trace;
+    Stream? destinoTraceProprio;
+
+    // dispositivos simulados em threads próprias (janelas conservadoras)
+    readonly CoordenadorDispositivos dispositivos = new(Environment.ProcessorCount > 1);
+    readonly Action<MensagemDispositivo> aplicarMensagem;
+
+    // tamanho do lote entre verificações de cancelamento / publicação em modo headless
+    const long LoteHeadless = 16_384;
+
+    // lote da thread dedicada (menor, para responder rápido a StopAuto)
+    const long LoteThread = 4_096;
+
+    // bytes de RAM incluídos nos snapshots publicados (mesmo preview do painel)
+    const int PreviewPublicado = 32;
 
     // Handlers nomeados para subscribe/unsubscribe corretos
     readonly EventHandler<ProjetoSimuladorPC.RAM.MemoryChangedEventArgs> ramMemoryChangedHandler;
@@ -34,6 +83,7 @@ public class SimulationEngine : IDisposable
     public SimulationEngine(SimulationState simulationState)
     {
         simState = simulationState ?? throw new ArgumentNullException(nameof(simulationState));
+        configAtiva = simState.Config?.Clone() ?? new Configuracoes();
 
         // reutiliza as fachadas existentes no SimulationState para manter referências visíveis ao UI
         ram = simState.Ram;
@@ -49,25 +99,37 @@ public class SimulationEngine : IDisposable
         cpuSimulator = new CpuSimulator(ram, pic, metrics, cpuState);
 
         // MMIO e DMA: mmio com faixa baseada no Config (fallback)
-        uint dmaBase = simState.Config?.DmaBase ?? 0x1000_0200;
-        mmio = new DispositivoMMIO((int)dmaBase, (int)(dmaBase + 0xFF)); // faixa simples
-        dmaSim = new DMA.DMA(ram, mmio, dmaState);
+        mmio = CriarMmio(configAtiva);
+        dmaSim = CriarDma(configAtiva);
 
         // Cache: cria uma instância de Cache ligada à fachada CacheState do SimulationState
         var cacheState = simState.Cache;
-        int cacheSizeBytes = ParseMemorySize(simState.Config?.L1Size) ?? 16 * 1024;
-        int blockSize = Math.Max(1, simState.Config?.L1LineSize ?? 64);
-        int assoc = Math.Max(1, simState.Config?.L1Assoc ?? 2);
-        var wp = (simState.Config?.L1WritePolicy ?? "WT").ToUpperInvariant() == "WT" ? WritePolicy.WriteThrough : WritePolicy.WriteBack;
-        // substituição fixa LRU para simplificação
-        cacheSim = new Cache.Cache(cacheSizeBytes, blockSize, assoc, ReplacementPolicy.LRU, wp, cacheState);
+        cacheSim = CriarCache(configAtiva, cacheState);
+
+        // Timer periódico: primeiro dispositivo orientado a eventos (IRQ desabilitada por padrão)
+        timer = new DispositivoTimer(scheduler, pic, Math.Max(1, configAtiva.TimerPeriodCycles));
+        timer.Iniciar(simState.CicloAtual);
+
+        // o PIC mede a latência das IRQs no relógio da CPU (registrada só com amostragem ativa)
+        pic.Relogio = () => cpuSimulator.Ciclos;
+        pic.IrqReconhecida = (_, latencia) => Volatile.Read(ref desempenho)?.RegistrarLatenciaIrq(latencia);
 
         // ANEXA a cache à RAM para que acessos reais atualizem estatísticas
         ram.AttachCache(cacheSim);
 
+        aplicarMensagem = AplicarMensagemDispositivo;
+
         // cria handlers nomeados que notificam o SimulationState
-        ramMemoryChangedHandler = (_, __) => simState.NotifyStateChanged();
-        dmaStateChangedHandler = (_, __) => simState.NotifyStateChanged();
+        ramMemoryChangedHandler = (_, __) =>
+        {
+            if (Volatile.Read(ref notificacoesSuspensas) == 0) simState.NotifyStateChanged();
+        };
+        // rajadas do DMA dirigido por ciclos chegam da thread do motor: dentro de um lote o
+        // progresso segue no PublicarEstado do fim do lote
+        dmaStateChangedHandler = (_, __) =>
+        {
+            if (Volatile.Read(ref notificacoesSuspensas) == 0) simState.NotifyStateChanged();
+        };
 
         // Subscrições para propagar mudanças à UI (usando handlers nomeados)
         ram.MemoryChanged += ramMemoryChangedHandler;
@@ -78,6 +140,54 @@ public class SimulationEngine : IDisposable
         simState.Ram = ram;
         simState.Cache = cacheState;
         simState.Dma = dmaState;
+
+        GravarQuadro();
+    }
+
+    /// <summary>
+    /// Fila de eventos do motor. Só deve ser manipulada a partir de callbacks de eventos
+    /// (que já executam na thread do motor); de fora, use <see cref="AgendarEvento"/>.
+    /// </summary>
+    public EventScheduler Scheduler => scheduler;
+
+    public DispositivoTimer Timer => timer;
+
+    /// <summary>
+    /// Contadores da CPU (instruções, ciclos, interrupções). Leitura sem lock.
+    /// </summary>
+    public Metrics Metricas => metrics;
+
+    /// <summary>
+    /// Séries temporais de desempenho amostradas periodicamente (painel Desempenho). A amostragem
+    /// começa no primeiro acesso a esta propriedade.
+    /// </summary>
+    public AmostradorDesempenho Desempenho =>
+        LazyInitializer.EnsureInitialized(ref desempenho, ref desempenhoSync, () => new AmostradorDesempenho(LerContadores));
+
+    // leitura sem lock: valores podem estar um lote atrasados, o que basta para taxas
+    ContadoresMotor LerContadores()
+    {
+        var cache = cacheSim;
+        return new ContadoresMotor(
+            Ciclos: simState.CicloAtual,
+            Instrucoes: metrics.InstructionsExecuted,
+            TicksExecucao: Volatile.Read(ref ticksExecucao),
+            AcessosCache: cache.Reads + cache.Writes,
+            HitsCache: cache.Hits,
+            BytesDma: dmaState.TotalBytesTransferidos
+        );
+    }
+
+    /// <summary>
+    /// Agenda um callback para daqui a <paramref name="ciclosAFrente"/> ciclos (thread-safe).
+    /// </summary>
+    public EventoAgendado AgendarEvento(long ciclosAFrente, Action<long> callback, string? nome = null)
+    {
+        if (ciclosAFrente < 0) throw new ArgumentOutOfRangeException(nameof(ciclosAFrente));
+        lock (execSync)
+        {
+            return scheduler.Agendar(simState.CicloAtual + ciclosAFrente, callback, nome);
+        }
     }
 
     /// <summary>
@@ -85,45 +195,1133 @@ public class SimulationEngine : IDisposable
     /// </summary>
     public void AdvanceOneCycle()
     {
-        // CPU executa instrução / trata IRQs
-        cpuSimulator.Tick();
+        lock (execSync)
+        {
+            // CPU executa instrução / trata IRQs; eventos vencidos disparam antes do tick
+            ExecutarCiclos(1, null);
 
-        // opcional: atualizar contadores da cache na fachada (forçar sync)
-        cacheSim.UpdateState();
+            // opcional: atualizar contadores da cache na fachada (forçar sync)
+            cacheSim.UpdateState();
+        }
 
-        // incrementa ciclo global e notifica UI
-        simState.AdvanceCycle(1);
+        // uma única notificação por ciclo
         simState.NotifyStateChanged();
     }
 
     /// <summary>
-    /// Inicia transferência DMA assincronamente.
+    /// Resultado da última execução em lote (RunCycles/RunUntil), ou null.
+    /// </summary>
+    public RunResult? UltimoResultado { get; private set; }
+
+    /// <summary>
+    /// Executa <paramref name="ciclos"/> ciclos num laço fechado, sem notificar a UI por ciclo
+    /// nem sincronizar a fachada da cache por acesso. Publica um snapshot ao final e, se
+    /// <paramref name="publicacoesPorSegundo"/> &gt; 0, também periodicamente durante a execução.
+    /// </summary>
+    public RunResult RunCycles(long ciclos, CancellationToken ct = default, double publicacoesPorSegundo = 0)
+    {
+        if (ciclos < 0) throw new ArgumentOutOfRangeException(nameof(ciclos));
+        return ExecutarHeadless(ciclos, null, ct, publicacoesPorSegundo);
+    }
+
+    /// <summary>
+    /// Executa até que <paramref name="condicao"/> seja verdadeira (avaliada após cada ciclo)
+    /// ou até <paramref name="maxCiclos"/> ciclos. Mesmas garantias de <see cref="RunCycles"/>.
+    /// </summary>
+    public RunResult RunUntil(Func<SimulationState, bool> condicao, long maxCiclos = long.MaxValue, CancellationToken ct = default, double publicacoesPorSegundo = 0)
+    {
+        if (condicao is null) throw new ArgumentNullException(nameof(condicao));
+        if (maxCiclos < 0) throw new ArgumentOutOfRangeException(nameof(maxCiclos));
+        return ExecutarHeadless(maxCiclos, condicao, ct, publicacoesPorSegundo);
+    }
+
+    RunResult ExecutarHeadless(long maxCiclos, Func<SimulationState, bool>? condicao, CancellationToken ct, double publicacoesPorSegundo)
+    {
+        long instrucoesInicio = metrics.InstructionsExecuted;
+        long executados = 0;
+        bool atingida = false;
+
+        long ticksPorPublicacao = publicacoesPorSegundo > 0
+            ? Math.Max(1, (long)(Stopwatch.Frequency / publicacoesPorSegundo))
+            : long.MaxValue;
+        long proximaPublicacao = ticksPorPublicacao;
+
+        SuspenderNotificacoes();
+        var sw = Stopwatch.StartNew();
+        try
+        {
+            while (executados < maxCiclos && !atingida && !ct.IsCancellationRequested)
+            {
+                long lote = Math.Min(LoteHeadless, maxCiclos - executados);
+                lock (execSync)
+                {
+                    long feitos = ExecutarCiclos(lote, condicao);
+                    executados += feitos;
+                    atingida = condicao is not null && feitos < lote;
+                }
+
+                if (sw.ElapsedTicks >= proximaPublicacao)
+                {
+                    proximaPublicacao = sw.ElapsedTicks + ticksPorPublicacao;
+                    PublicarEstado();
+                }
+            }
+        }
+        finally
+        {
+            sw.Stop();
+            RetomarNotificacoes();
+        }
+
+        // verificação final (ex.: condição já verdadeira antes do primeiro ciclo, ou maxCiclos == 0)
+        if (!atingida && condicao is not null) atingida = condicao(simState);
+
+        var resultado = RunResult.Criar(executados, metrics.InstructionsExecuted - instrucoesInicio, sw.Elapsed,
+            atingida, ct.IsCancellationRequested);
+        UltimoResultado = resultado;
+
+        PublicarEstado();
+        return resultado;
+    }
+
+    void SuspenderNotificacoes()
+    {
+        lock (execSync)
+        {
+            notificacoesSuspensas++;
+            cacheSim.SincronizarFachada = false;
+        }
+    }
+
+    void RetomarNotificacoes()
+    {
+        lock (execSync)
+        {
+            notificacoesSuspensas--;
+            cacheSim.SincronizarFachada = notificacoesSuspensas == 0;
+        }
+    }
+
+    // grava o quadro lido por SimulationState.GetSnapshot (deve ser chamado sob execSync):
+    // contadores da própria cache (a fachada pode estar atrasada em lotes) e, com a DMA
+    // dirigida por ciclos, o estado dela no mesmo ciclo
+    void GravarQuadro()
+    {
+        var c = cacheSim;
+        simState.PublicarQuadro(
+            new ContadoresCache(c.Reads, c.Writes, c.Hits, c.Misses, c.MemoryWrites),
+            dmaSim.DirigidaPorCiclos ? dmaState.GetSnapshot() : null,
+            simState.Config);
+    }
+
+    // sincroniza as fachadas, publica um snapshot imutável e dispara uma única notificação
+    void PublicarEstado()
+    {
+        SimulationSnapshot snap;
+        lock (execSync)
+        {
+            cacheSim.UpdateState();
+            GravarQuadro();
+            snap = simState.GetSnapshot(0, PreviewPublicado);
+        }
+        simState.PublishSnapshot(snap);
+        SimuladorEventSource.Log.SnapshotPublicado(simState.Versao);
+    }
+
+    /// <summary>
+    /// Núcleo de eventos discretos: alterna quanta de CPU com os eventos vencidos.
+    /// Um evento agendado para o ciclo C dispara quando C ciclos já foram executados,
+    /// antes do tick seguinte. Com a CPU ociosa, salta direto ao próximo evento.
+    /// Se <paramref name="parada"/> for informada, é avaliada após cada tick e interrompe o lote.
+    /// Deve ser chamado com <see cref="execSync"/> adquirido. Atualiza CicloAtual sem notificar
+    /// e retorna o número de ciclos executados.
+    /// </summary>
+    long ExecutarCiclos(long quantidade, Func<SimulationState, bool>? parada)
+    {
+        var log = SimuladorEventSource.Log;
+        bool instrumentado = log.IsEnabled();
+        long instrucoesAntes = 0;
+        ulong hitsAntes = 0, missesAntes = 0;
+        if (instrumentado)
+        {
+            instrucoesAntes = metrics.InstructionsExecuted;
+            hitsAntes = cacheSim.Hits;
+            missesAntes = cacheSim.Misses;
+            log.LoteInicio(simState.CicloAtual, quantidade);
+        }
+
+        long t0 = Stopwatch.GetTimestamp();
+        long feitos = 0;
+        try
+        {
+            feitos = reverso is { } r ? r.Executar(quantidade, parada) : ExecutarCiclosNucleo(quantidade, parada);
+            return feitos;
+        }
+        finally
+        {
+            // fronteira de lote: leitores passam a ver este ciclo por inteiro
+            GravarQuadro();
+            Volatile.Write(ref ticksExecucao, ticksExecucao + Stopwatch.GetTimestamp() - t0);
+            if (instrumentado)
+            {
+                log.CiclosExecutados(feitos, metrics.InstructionsExecuted - instrucoesAntes,
+                    (long)(cacheSim.Hits - hitsAntes), (long)(cacheSim.Misses - missesAntes));
+                log.LoteFim(simState.CicloAtual, feitos);
+            }
+        }
+    }
+
+    internal long ExecutarCiclosNucleo(long quantidade, Func<SimulationState, bool>? parada)
+    {
+        long inicio = simState.CicloAtual;
+        long ciclo = inicio;
+        long alvo = inicio + quantidade;
+
+        while (true)
+        {
+            int disparados = scheduler.ExecutarVencidos(ciclo);
+            if (disparados > 0) SimuladorEventSource.Log.EventosDisparados(ciclo, disparados);
+            dispositivos.Sincronizar(ciclo, aplicarMensagem);
+            if (ciclo >= alvo) break;
+
+            // fim da janela dos dispositivos paralelos ou entrega de mensagem deles
+            long limiteDispositivos = dispositivos.ProximoLimite;
+
+            if (cpuSimulator.EstaOciosa && parada is null)
+            {
+                long limite = Math.Min(alvo, Math.Min(scheduler.ProximoCiclo, limiteDispositivos));
+                cpuSimulator.AvancarOcioso(limite - ciclo);
+                ciclo = limite;
+                continue;
+            }
+
+            // quantum de CPU: sem custo por dispositivo, apenas compara com o próximo evento
+            bool parou = false;
+            while (ciclo < alvo && ciclo < scheduler.ProximoCiclo && ciclo < limiteDispositivos)
+            {
+                cpuSimulator.Tick();
+                ciclo++;
+                if (parada is not null)
+                {
+                    // a condição observa o ciclo já contabilizado
+                    simState.AdvanceCycleSilently(1);
+                    if (parada(simState)) { parou = true; break; }
+                }
+            }
+
+            if (parou)
+            {
+                scheduler.ExecutarVencidos(ciclo);
+                dispositivos.Sincronizar(ciclo, aplicarMensagem);
+                dispositivos.Aguardar();
+                return ciclo - inicio;
+            }
+        }
+
+        // estado dos dispositivos estável entre lotes
+        dispositivos.Aguardar();
+        if (parada is null) simState.AdvanceCycleSilently(ciclo - inicio);
+        return ciclo - inicio;
+    }
+
+    void AplicarMensagemDispositivo(MensagemDispositivo mensagem)
+    {
+        switch (mensagem.Tipo)
+        {
+            case TipoMensagemDispositivo.Irq:
+                pic.RaiseIrq((int)mensagem.Valor);
+                break;
+            case TipoMensagemDispositivo.EscritaRam:
+                ram.Escrever(mensagem.Endereco, mensagem.Dados!);
+                break;
+        }
+    }
+
+    /// <summary>
+    /// Registra um dispositivo simulado em paralelo com a CPU (ver <see cref="CoordenadorDispositivos"/>),
+    /// a partir do ciclo atual. Com dispositivos registrados, checkpoints e depuração reversa
+    /// ficam indisponíveis (o estado interno deles não é restaurável).
+    /// </summary>
+    public void AdicionarDispositivo(DispositivoParalelo dispositivo)
+    {
+        if (dispositivo is null) throw new ArgumentNullException(nameof(dispositivo));
+        lock (execSync)
+        {
+            if (reverso is not null) throw new InvalidOperationException("Desative a depuração reversa antes de adicionar dispositivos.");
+            dispositivos.Adicionar(dispositivo, simState.CicloAtual);
+        }
+    }
+
+    /// <summary>
+    /// Escreve <paramref name="valor"/> no registrador <paramref name="registro"/> do dispositivo;
+    /// a escrita tem efeito no dispositivo após a latência dele.
+    /// </summary>
+    public void EnviarAoDispositivo(DispositivoParalelo dispositivo, int registro, long valor)
+    {
+        if (dispositivo is null) throw new ArgumentNullException(nameof(dispositivo));
+        lock (execSync)
+        {
+            if (dispositivo.Indice < 0 || dispositivo.Indice >= dispositivos.Dispositivos.Count
+                || !ReferenceEquals(dispositivos.Dispositivos[dispositivo.Indice], dispositivo))
+                throw new ArgumentException("Dispositivo não registrado neste motor.", nameof(dispositivo));
+            dispositivos.Enviar(dispositivo, simState.CicloAtual, registro, valor);
+        }
+    }
+
+    public DispositivoParalelo? ObterDispositivo(int indice)
+    {
+        lock (execSync)
+        {
+            var lista = dispositivos.Dispositivos;
+            return indice >= 0 && indice < lista.Count ? lista[indice] : null;
+        }
+    }
+
+    /// <summary>
+    /// Situação dos dispositivos paralelos (lida entre lotes, com os dispositivos parados).
+    /// </summary>
+    public IReadOnlyList<InfoDispositivo> ListarDispositivos()
+    {
+        lock (execSync)
+        {
+            var lista = new List<InfoDispositivo>(dispositivos.Dispositivos.Count);
+            foreach (var d in dispositivos.Dispositivos)
+                lista.Add(new InfoDispositivo(d.Indice, d.Nome, d.GetType().Name, d.LatenciaCiclos, d.CicloLocal, d.Resumo()));
+            return lista;
+        }
+    }
+
+    /// <summary>
+    /// Threads dedicadas para os dispositivos (padrão: se o host tiver mais de um núcleo).
+    /// Não altera os resultados; só pode mudar antes do primeiro <see cref="AdicionarDispositivo"/>.
+    /// </summary>
+    public bool DispositivosEmParalelo
+    {
+        get => dispositivos.Paralelo;
+        set { lock (execSync) { dispositivos.Paralelo = value; } }
+    }
+
+    void ExigirSemDispositivos(string operacao)
+    {
+        if (dispositivos.Dispositivos.Count > 0)
+            throw new InvalidOperationException($"{operacao} indisponível com dispositivos paralelos registrados.");
+    }
+
+    /// <summary>
+    /// Inicia transferência DMA assincronamente. No modo determinístico (ou com a depuração
+    /// reversa ativa) a transferência avança pelos ciclos da simulação e
+    /// <paramref name="delayMs"/> é ignorado; a Task retornada completa assim que ela é iniciada.
     /// </summary>
     public Task StartDmaAsync(int origem, int destino, int tamanho, int delayMs = 10)
     {
+        lock (execSync)
+        {
+            if (configAtiva.Deterministico || reverso is not null)
+            {
+                dmaSim.IniciarTransferenciaPorCiclos(origem, destino, tamanho, simState.CicloAtual);
+                reverso?.Registrar(new DmaExterna(simState.CicloAtual, origem, destino, tamanho));
+                GravarQuadro();
+                return Task.CompletedTask;
+            }
+        }
         return dmaSim.ExecutarTransferenciaAsync(origem, destino, tamanho, delayMs);
     }
 
     /// <summary>
-    /// Inicia modo automático que chama AdvanceOneCycle em intervalo.
+    /// Escreve <paramref name="dados"/> na RAM a partir de fora da simulação (UI/API), no ciclo
+    /// atual. Com a depuração reversa ativa a escrita entra no histórico de entradas.
     /// </summary>
-    public void StartAuto(int intervalMs)
+    public void EscreverRam(int endereco, byte[] dados)
     {
-        StopAuto();
-        autoTimer = new System.Threading.Timer(_ =>
+        if (dados is null) throw new ArgumentNullException(nameof(dados));
+        lock (execSync)
         {
-            try { AdvanceOneCycle(); }
-            catch { }
-        }, null, 0, Math.Max(1, intervalMs));
+            ram.Escrever(endereco, dados);
+            reverso?.Registrar(new EscritaRamExterna(simState.CicloAtual, endereco, (byte[])dados.Clone()));
+        }
+        if (notificacoesSuspensas == 0) PublicarEstado();
+    }
+
+    /// <summary>
+    /// Depuração reversa ativa, ou null.
+    /// </summary>
+    public DepuradorReverso? Reverso => reverso;
+
+    /// <summary>
+    /// Ativa a depuração reversa a partir do ciclo atual (histórico anterior, se houver, é
+    /// descartado). Lança <see cref="InvalidOperationException"/> com DMA em andamento, pois a
+    /// transferência assíncrona não seria reexecutável.
+    /// </summary>
+    public DepuradorReverso AtivarDepuracaoReversa(OpcoesDepuracaoReversa? opcoes = null)
+    {
+        lock (execSync)
+        {
+            if (dmaState.EmExecucao && !dmaSim.DirigidaPorCiclos)
+                throw new InvalidOperationException("Transferência DMA em andamento.");
+            ExigirSemDispositivos("Depuração reversa");
+
+            var novo = new DepuradorReverso(this, opcoes ?? new OpcoesDepuracaoReversa());
+            reverso?.Desligar();
+            reverso = novo;
+            novo.Reiniciar();
+            return novo;
+        }
+    }
+
+    public void DesativarDepuracaoReversa()
+    {
+        lock (execSync)
+        {
+            reverso?.Desligar();
+            reverso = null;
+        }
+    }
+
+    /// <summary>
+    /// Verdadeiro enquanto um trace de execução está sendo gravado.
+    /// </summary>
+    public bool TraceAtivo => trace is not null;
+
+    /// <summary>
+    /// Começa a gravar um trace de instruções e acessos à memória em <paramref name="destino"/>
+    /// (formato <see cref="FormatoTrace"/>). O ciclo dos registros é o contador da CPU. Lança
+    /// <see cref="InvalidOperationException"/> se já houver um trace em andamento.
+    /// Com <paramref name="manterAberto"/> falso, o stream é fechado por <see cref="PararTrace"/>.
+    /// </summary>
+    public void IniciarTrace(Stream destino, bool comprimir = true, bool manterAberto = true)
+    {
+        if (destino is null) throw new ArgumentNullException(nameof(destino));
+        lock (execSync)
+        {
+            if (trace is not null) throw new InvalidOperationException("Já existe um trace em andamento.");
+            var escritor = new EscritorTrace(destino, () => cpuSimulator.Ciclos, comprimir);
+            ram.Observador = escritor;
+            cpuSimulator.Observador = escritor;
+            trace = escritor;
+            destinoTraceProprio = manterAberto ? null : destino;
+        }
+    }
+
+    /// <summary>
+    /// Encerra o trace em andamento (grava o que falta e a marca de fim) e retorna seu resumo,
+    /// ou null se não havia trace.
+    /// </summary>
+    public ResumoTrace? PararTrace()
+    {
+        EscritorTrace? escritor;
+        Stream? proprio;
+        lock (execSync)
+        {
+            escritor = trace;
+            proprio = destinoTraceProprio;
+            trace = null;
+            destinoTraceProprio = null;
+            ram.Observador = null;
+            cpuSimulator.Observador = null;
+        }
+
+        try
+        {
+            return escritor?.Finalizar();
+        }
+        finally
+        {
+            proprio?.Dispose();
+        }
+    }
+
+    const int LoteReproducao = 16_384;
+
+    /// <summary>
+    /// Modo dirigido por trace: reproduz os acessos de <paramref name="fonte"/> numa cache nova,
+    /// com a geometria da configuração ativa, sem executar instruções, e estima o tempo com
+    /// <see cref="ModeloTempoMemoria"/>. A máquina (RAM, cache, contadores, CPU) não é tocada,
+    /// de modo que a reprodução pode correr junto com a execução automática.
+    /// </summary>
+    public ResultadoReproducao ReproduzirTrace(IFonteTrace fonte, CancellationToken ct = default)
+    {
+        if (fonte is null) throw new ArgumentNullException(nameof(fonte));
+
+        Configuracoes config;
+        lock (execSync) config = configAtiva;
+        var modelo = ModeloTempoMemoria.De(config);
+        var cache = CriarCache(config, null);
+
+        var lote = new RegistroTrace[LoteReproducao];
+        var resultados = new ResultadoAcesso[LoteReproducao];
+        long registros = 0, instrucoes = 0, leituras = 0, escritas = 0, falhas = 0, escritasMemoria = 0, ciclos = 0;
+
+        var sw = Stopwatch.StartNew();
+        int n;
+        while (!ct.IsCancellationRequested && (n = fonte.Ler(lote)) > 0)
+        {
+            ReprodutorTrace.AcessarLote(cache, lote.AsSpan(0, n), resultados);
+
+            for (int i = 0; i < n; i++)
+            {
+                ref readonly var r = ref lote[i];
+                if (r.Tipo == TipoRegistroTrace.Instrucao)
+                {
+                    instrucoes++;
+                    ciclos += modelo.CiclosInstrucao;
+                    continue;
+                }
+
+                if (r.Tipo == TipoRegistroTrace.Escrita) escritas++; else leituras++;
+                var efeito = resultados[i];
+                if ((efeito & ResultadoAcesso.Falha) != 0)
+                {
+                    falhas++;
+                    ciclos += modelo.CiclosFalha;
+                }
+                else
+                {
+                    ciclos += modelo.CiclosAcerto;
+                }
+                if ((efeito & ResultadoAcesso.EscritaMemoria) != 0)
+                {
+                    escritasMemoria++;
+                    ciclos += modelo.CiclosEscritaMemoria(r.Tamanho);
+                }
+            }
+            registros += n;
+        }
+        sw.Stop();
+
+        long acessos = leituras + escritas;
+        double segundos = sw.Elapsed.TotalSeconds;
+        return new ResultadoReproducao(
+            Registros: registros,
+            Instrucoes: instrucoes,
+            Leituras: leituras,
+            Escritas: escritas,
+            Acertos: acessos - falhas,
+            Falhas: falhas,
+            EscritasMemoria: escritasMemoria,
+            CiclosModelados: ciclos,
+            CiclosGravados: fonte is LeitorTrace lt && !ct.IsCancellationRequested ? lt.CicloFinal - lt.CicloInicial : null,
+            Duracao: sw.Elapsed,
+            RegistrosPorSegundo: segundos > 0 ? registros / segundos : 0,
+            Cancelado: ct.IsCancellationRequested);
+    }
+
+    // acesso do depurador reverso ao motor; todos chamados sob execSync
+    internal object Sincronizacao => execSync;
+    internal SimulationState Estado => simState;
+    internal RamState Ram => ram;
+    internal Configuracoes ConfigAtiva => configAtiva;
+
+    internal long ExecutarSobBloqueio(long quantidade, Func<SimulationState, bool>? parada) => ExecutarCiclos(quantidade, parada);
+
+    // executa uma navegação atômica no histórico, com uma única publicação ao final
+    internal T Navegar<T>(Func<T> acao)
+    {
+        SuspenderNotificacoes();
+        try
+        {
+            lock (execSync) return acao();
+        }
+        finally
+        {
+            RetomarNotificacoes();
+            PublicarEstado();
+        }
+    }
+
+    internal void AplicarEntrada(EntradaExterna entrada)
+    {
+        reproduzindoEntradas = true;
+        try
+        {
+            switch (entrada)
+            {
+                case EscritaRamExterna e:
+                    ram.Escrever(e.Endereco, e.Dados);
+                    break;
+                case DmaExterna d:
+                    dmaSim.IniciarTransferenciaPorCiclos(d.Origem, d.Destino, d.Tamanho, d.Ciclo);
+                    break;
+                case ConfiguracaoExterna c:
+                    Reconfigurar(c.Config, c.MigrarCache);
+                    break;
+            }
+        }
+        finally
+        {
+            reproduzindoEntradas = false;
+        }
+    }
+
+    // estado de dispositivos (sem configuração e RAM) em memória, sem compressão
+    internal byte[] CapturarDispositivos()
+    {
+        var ms = new MemoryStream();
+        using (var escritor = new EscritorCheckpoint(ms, simState.CicloAtual, comprimir: false))
+        {
+            EscreverDispositivos(escritor);
+            escritor.Finalizar();
+        }
+        return ms.ToArray();
+    }
+
+    internal void RestaurarDispositivos(byte[] dados, Configuracoes config, long ciclo)
+    {
+        AplicarConfiguracaoRestaurada(config);
+        using var leitor = new LeitorCheckpoint(new MemoryStream(dados, writable: false));
+        while (leitor.ProximaSecao(out var secao)) RestaurarDispositivo(secao, leitor.LerSecao());
+        simState.CicloAtual = ciclo;
+    }
+
+    // aplica a configuração de um ponto restaurado sem registrá-la como entrada;
+    // nada é reconstruído se ela for igual à ativa (caso comum ao navegar no histórico)
+    void AplicarConfiguracaoRestaurada(Configuracoes config)
+    {
+        if (JsonSerializer.Serialize(config) == JsonSerializer.Serialize(configAtiva)) return;
+
+        bool anterior = reproduzindoEntradas;
+        reproduzindoEntradas = true;
+        try
+        {
+            Reconfigurar(config, migrarCache: false);
+        }
+        finally
+        {
+            reproduzindoEntradas = anterior;
+        }
+    }
+
+    /// <summary>
+    /// Máximo de snapshots publicados por segundo pela thread de simulação.
+    /// </summary>
+    public double PublicacoesPorSegundo { get; set; } = 30;
+
+    /// <summary>
+    /// Modo da thread automática em execução, ou null se parada.
+    /// </summary>
+    public ModoExecucao? ModoAtual { get; private set; }
+
+    public bool EmExecucao => simThread is { IsAlive: true };
+
+    /// <summary>
+    /// Ritmo do modo relógio (deriva, razão atingida, fator de lentidão), atualizado a cada
+    /// publicação; null fora do modo <see cref="ModoExecucao.Relogio"/>.
+    /// </summary>
+    public PacingStatus? StatusRelogio { get; private set; }
+
+    /// <summary>
+    /// Falha que encerrou a última execução automática, ou null (limpo a cada início).
+    /// </summary>
+    public string? ErroAuto { get; private set; }
+
+    /// <summary>
+    /// Inicia modo automático que avança um ciclo a cada <paramref name="intervalMs"/>.
+    /// </summary>
+    public void StartAuto(int intervalMs) => StartAuto(ModoExecucao.Intervalo, intervalMs);
+
+    /// <summary>
+    /// Inicia a thread dedicada de simulação no modo indicado. A thread executa em lotes sem
+    /// notificações por ciclo e publica snapshots imutáveis no máximo
+    /// <see cref="PublicacoesPorSegundo"/> vezes por segundo.
+    /// </summary>
+    public void StartAuto(ModoExecucao modo, int intervalMs = 1)
+    {
+        lock (autoSync)
+        {
+            PararThread();
+            pararThread = false;
+            sinalParada.Reset();
+            ErroAuto = null;
+
+            var t = new Thread(() => LacoSimulacao(modo, Math.Max(1, intervalMs)))
+            {
+                IsBackground = true,
+                Name = "SimulationEngine"
+            };
+            simThread = t;
+            ModoAtual = modo;
+            t.Start();
+        }
     }
 
     public void StopAuto()
     {
-        autoTimer?.Dispose();
-        autoTimer = null;
+        lock (autoSync)
+        {
+            PararThread();
+        }
     }
 
-    static int? ParseMemorySize(string? s)
+    void PararThread()
+    {
+        var t = simThread;
+        if (t is null) return;
+
+        pararThread = true;
+        sinalParada.Set();
+        if (t != Thread.CurrentThread) t.Join();
+
+        simThread = null;
+        ModoAtual = null;
+    }
+
+    void LacoSimulacao(ModoExecucao modo, int intervalMs)
+    {
+        long instrucoesInicio = metrics.InstructionsExecuted;
+        long executados = 0;
+        long proximaPublicacao = 0;
+
+        ClockPacer? pacer = null;
+        if (modo == ModoExecucao.Relogio)
+        {
+            pacer = new ClockPacer(Math.Max(1, simState.Config?.ClockHz ?? 100_000_000), LoteThread);
+            pacer.Iniciar();
+        }
+        StatusRelogio = null;
+
+        if (SimuladorEventSource.Log.IsEnabled()) SimuladorEventSource.Log.ExecucaoIniciada(modo.ToString());
+        SuspenderNotificacoes();
+        var sw = Stopwatch.StartNew();
+        try
+        {
+            while (!pararThread)
+            {
+                long lote;
+                switch (modo)
+                {
+                    case ModoExecucao.Intervalo:
+                        lote = 1;
+                        break;
+
+                    case ModoExecucao.Relogio:
+                        // ciclos devidos segundo o relógio alvo; adiantado -> dorme/gira até o próximo
+                        pacer!.DefinirFrequencia(Math.Max(1, simState.Config?.ClockHz ?? 100_000_000));
+                        lote = pacer.ProximoLote();
+                        if (lote == 0)
+                        {
+                            pacer.Aguardar(sinalParada);
+                            continue;
+                        }
+                        break;
+
+                    default:
+                        lote = LoteThread;
+                        break;
+                }
+
+                long feitos;
+                lock (execSync)
+                {
+                    feitos = ExecutarCiclos(lote, null);
+                }
+                executados += feitos;
+                pacer?.Registrar(feitos);
+
+                if (sw.ElapsedTicks >= proximaPublicacao)
+                {
+                    double fps = PublicacoesPorSegundo;
+                    proximaPublicacao = sw.ElapsedTicks + (fps > 0 ? (long)(Stopwatch.Frequency / fps) : Stopwatch.Frequency);
+                    if (pacer is not null) StatusRelogio = pacer.ObterStatus();
+                    PublicarEstado();
+                }
+
+                if (modo == ModoExecucao.Intervalo) sinalParada.Wait(intervalMs);
+            }
+        }
+        catch (Exception ex)
+        {
+            // falha na simulação encerra o modo automático de forma visível; a thread morta é
+            // recolhida pelo próximo StartAuto/StopAuto
+            ErroAuto = ex.Message;
+            ModoAtual = null;
+            SimuladorEventSource.Log.ExecucaoFalhou(simState.CicloAtual, ex.ToString());
+        }
+        finally
+        {
+            sw.Stop();
+            RetomarNotificacoes();
+            UltimoResultado = RunResult.Criar(executados, metrics.InstructionsExecuted - instrucoesInicio, sw.Elapsed, false, false);
+            SimuladorEventSource.Log.ExecucaoEncerrada(executados);
+            if (pacer is not null) StatusRelogio = pacer.ObterStatus();
+            PublicarEstado();
+        }
+    }
+
+    /// <summary>
+    /// Aplica uma nova configuração na próxima fronteira de ciclo segura (entre lotes), sem
+    /// realocar a RAM nem perder o estado da CPU. Reconstrói apenas o que mudou:
+    /// a cache (com migração opcional do conteúdo, preservando os contadores acumulados),
+    /// a faixa MMIO/DMA e o período do timer.
+    /// ClockHz é lido a cada lote pelo modo relógio e vale imediatamente.
+    /// Lança <see cref="System.ComponentModel.DataAnnotations.ValidationException"/> ou
+    /// <see cref="ArgumentException"/> se a configuração for inválida e
+    /// <see cref="InvalidOperationException"/> se DmaBase mudar com uma transferência DMA em
+    /// andamento (a faixa não pode ser trocada no meio dela); nesses casos nada muda.
+    /// </summary>
+    public ResultadoReconfiguracao Reconfigurar(Configuracoes nova, bool migrarCache = true)
+    {
+        if (nova is null) throw new ArgumentNullException(nameof(nova));
+        nova.Validate();
+        nova = nova.Clone();
+
+        bool cacheReconstruida = false, mmioReconstruido = false, timerReajustado = false;
+        int linhasMigradas = 0;
+
+        lock (execSync)
+        {
+            var atual = configAtiva;
+
+            // restaurações (checkpoint/depuração reversa) sobrescrevem também o estado do DMA
+            if (atual.DmaBase != nova.DmaBase && dmaState.EmExecucao && !reproduzindoEntradas)
+                throw new InvalidOperationException("Transferência DMA em andamento: aguarde o término para mudar DmaBase.");
+
+            // cria antes de registrar e trocar: geometria inválida lança sem efeito colateral
+            // (nem entrada no histórico da depuração reversa, nem futuro descartado)
+            var novaCache = GeometriaCacheMudou(atual, nova) ? CriarCache(nova, simState.Cache) : null;
+
+            if (reverso is { } r && !reproduzindoEntradas)
+                r.Registrar(new ConfiguracaoExterna(simState.CicloAtual, nova.Clone(), migrarCache));
+
+            if (novaCache is not null)
+            {
+                var antiga = cacheSim;
+                novaCache.SincronizarFachada = antiga.SincronizarFachada;
+
+                if (migrarCache)
+                {
+                    foreach (var (endereco, dirty) in antiga.ExportarLinhas())
+                    {
+                        novaCache.ImportarLinha(endereco, dirty);
+                        linhasMigradas++;
+                    }
+                }
+                novaCache.RestaurarContadores(antiga.Reads, antiga.Writes, antiga.Hits, antiga.Misses, antiga.MemoryWrites);
+
+                ram.AttachCache(novaCache);
+                cacheSim = novaCache;
+                cacheReconstruida = true;
+            }
+
+            if (atual.DmaBase != nova.DmaBase)
+            {
+                mmio = CriarMmio(nova);
+                dmaSim = CriarDma(nova);
+                mmioReconstruido = true;
+            }
+            AjustarRajadasDma(dmaSim, nova);
+
+            if (atual.TimerPeriodCycles != nova.TimerPeriodCycles)
+            {
+                timer.DefinirPeriodo(Math.Max(1, nova.TimerPeriodCycles), simState.CicloAtual);
+                timerReajustado = true;
+            }
+
+            configAtiva = nova;
+            simState.Config = nova.Clone();
+            GravarQuadro();
+        }
+
+        simState.NotifyStateChanged();
+        SimuladorEventSource.Log.Reconfigurado(cacheReconstruida, mmioReconstruido, timerReajustado);
+
+        return new ResultadoReconfiguracao(cacheReconstruida, linhasMigradas, mmioReconstruido, timerReajustado, Aviso: null);
+    }
+
+    /// <summary>
+    /// Grava um checkpoint completo da máquina (configuração, CPU, métricas, cache, PIC, timer,
+    /// DMA e RAM) na próxima fronteira entre lotes. A execução fica bloqueada durante a gravação;
+    /// a thread automática, se ativa, continua em seguida. Formato: <see cref="FormatoCheckpoint"/>.
+    /// </summary>
+    public InfoCheckpoint SalvarCheckpoint(Stream destino, bool comprimir = true)
+    {
+        if (destino is null) throw new ArgumentNullException(nameof(destino));
+
+        lock (execSync)
+        {
+            ExigirSemDispositivos("Checkpoint");
+            cacheSim.UpdateState();
+            using var escritor = new EscritorCheckpoint(destino, simState.CicloAtual, comprimir);
+            escritor.Secao(SecaoCheckpoint.Configuracao, w => w.Write(JsonSerializer.Serialize(configAtiva)));
+            EscreverDispositivos(escritor);
+            ram.ComMemoria(escritor.Ram);
+            return escritor.Finalizar();
+        }
+    }
+
+    // seções de estado de tudo, exceto configuração e RAM
+    void EscreverDispositivos(EscritorCheckpoint escritor)
+    {
+        escritor.Secao(SecaoCheckpoint.Cpu, cpuSimulator.SalvarEstado);
+        escritor.Secao(SecaoCheckpoint.Metricas, SalvarMetricas);
+        escritor.Secao(SecaoCheckpoint.Cache, cacheSim.SalvarEstado);
+        escritor.Secao(SecaoCheckpoint.Pic, pic.SalvarEstado);
+        escritor.Secao(SecaoCheckpoint.Timer, timer.SalvarEstado);
+        escritor.Secao(SecaoCheckpoint.Dma, dmaState.SalvarEstado);
+        escritor.Secao(SecaoCheckpoint.DmaAgenda, dmaSim.SalvarAgenda);
+    }
+
+    void SalvarMetricas(BinaryWriter w)
+    {
+        w.Write(metrics.InstructionsExecuted);
+        w.Write(metrics.TotalCycles);
+        w.Write(metrics.MemoryWrites);
+        w.Write(metrics.InterruptsHandled);
+        w.Write(metrics.InterruptsReturned);
+    }
+
+    /// <summary>
+    /// Resumo SHA-256 (hexadecimal) do estado simulado: ciclo, configuração, CPU, métricas, cache,
+    /// PIC, timer, progresso do DMA e RAM. Carimbos de tempo do host ficam de fora, então duas
+    /// execuções no modo determinístico com a mesma configuração e carga têm a mesma assinatura.
+    /// </summary>
+    public string AssinaturaEstado()
+    {
+        using var hash = IncrementalHash.CreateHash(HashAlgorithmName.SHA256);
+        lock (execSync)
+        {
+            var ms = new MemoryStream();
+            using (var w = new BinaryWriter(ms))
+            {
+                w.Write(simState.CicloAtual);
+                w.Write(JsonSerializer.Serialize(configAtiva));
+                cpuSimulator.SalvarEstado(w);
+                SalvarMetricas(w);
+                cacheSim.SalvarEstado(w);
+                pic.SalvarEstado(w);
+                timer.SalvarEstado(w);
+                var dma = dmaState.GetSnapshot();
+                w.Write(dma.EmExecucao);
+                w.Write(dma.Origem);
+                w.Write(dma.Destino);
+                w.Write(dma.Tamanho);
+                w.Write(dma.BytesTransferidos);
+                w.Write(dmaState.TotalBytesTransferidos);
+                dmaSim.SalvarAgenda(w);
+                if (dispositivos.Dispositivos.Count > 0) dispositivos.SalvarEstado(w);
+            }
+            hash.AppendData(ms.ToArray());
+            ram.ComMemoria(memoria => hash.AppendData(memoria));
+        }
+        return Convert.ToHexString(hash.GetHashAndReset());
+    }
+
+    // restaura uma seção de dispositivo; retorna false para as demais (não lidas)
+    bool RestaurarDispositivo(SecaoCheckpoint secao, BinaryReader r)
+    {
+        switch (secao)
+        {
+            case SecaoCheckpoint.Cpu:
+                cpuSimulator.RestaurarEstado(r);
+                return true;
+            case SecaoCheckpoint.Metricas:
+                RestaurarMetricas(metrics, r);
+                return true;
+            case SecaoCheckpoint.Cache:
+                cacheSim.RestaurarEstado(r);
+                return true;
+            case SecaoCheckpoint.Pic:
+                pic.RestaurarEstado(r);
+                return true;
+            case SecaoCheckpoint.Timer:
+                scheduler.Limpar();
+                timer.RestaurarEstado(r);
+                return true;
+            case SecaoCheckpoint.Dma:
+                dmaState.RestaurarEstado(r);
+                return true;
+            case SecaoCheckpoint.DmaAgenda:
+                // depois de Timer (que limpa a fila) e de Dma (estado da transferência)
+                dmaSim.RestaurarAgenda(r);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static void RestaurarMetricas(Metrics m, BinaryReader r)
+    {
+        m.InstructionsExecuted = r.ReadInt64();
+        m.TotalCycles = r.ReadInt64();
+        m.MemoryWrites = r.ReadInt64();
+        m.InterruptsHandled = r.ReadInt64();
+        m.InterruptsReturned = r.ReadInt64();
+    }
+
+    // checkpoint lido e validado por inteiro, ainda não aplicado à máquina
+    sealed record CheckpointPreparado(
+        Configuracoes? Config,
+        byte[]? Ram,
+        List<(SecaoCheckpoint Secao, byte[] Dados)> Secoes,
+        long Ciclo,
+        InfoCheckpoint Info);
+
+    /// <summary>
+    /// Restaura um checkpoint gravado por <see cref="SalvarCheckpoint"/>. A RAM atual deve ter o
+    /// mesmo tamanho; a configuração gravada é aplicada antes da cache. Eventos agendados
+    /// externamente (<see cref="AgendarEvento"/>) são descartados; o timer volta ao ciclo de
+    /// estouro gravado e uma transferência DMA interrompida é retomada de onde parou.
+    /// O checkpoint é lido e validado por inteiro antes de tocar a máquina (sem bloquear a
+    /// simulação) e então aplicado de uma vez: <see cref="InvalidDataException"/> para conteúdo
+    /// inválido e <see cref="InvalidOperationException"/> se houver DMA em andamento deixam o
+    /// estado intacto.
+    /// </summary>
+    public InfoCheckpoint RestaurarCheckpoint(Stream origem)
+    {
+        if (origem is null) throw new ArgumentNullException(nameof(origem));
+
+        var preparado = PrepararCheckpoint(origem);
+
+        lock (execSync)
+        {
+            if (dmaState.EmExecucao && !dmaSim.DirigidaPorCiclos)
+                throw new InvalidOperationException("Transferência DMA em andamento: aguarde o término antes de restaurar.");
+            ExigirSemDispositivos("Restauração de checkpoint");
+
+            if (preparado.Config is { } config) AplicarConfiguracaoRestaurada(config);
+            if (preparado.Ram is { } memoria) ram.ComMemoria(m => memoria.CopyTo(m, 0));
+            foreach (var (secao, dados) in preparado.Secoes)
+                RestaurarDispositivo(secao, LeitorSecao(dados));
+
+            simState.CicloAtual = preparado.Ciclo;
+
+            // checkpoints sem agenda de DMA (gravados com transferência assíncrona)
+            if (configAtiva.Deterministico || reverso is not null) dmaSim.RetomarTransferenciaPorCiclos(simState.CicloAtual);
+
+            // o histórico anterior não vale para a máquina restaurada
+            reverso?.Reiniciar();
+        }
+
+        if (dmaState.EmExecucao && !dmaSim.DirigidaPorCiclos) _ = dmaSim.RetomarTransferenciaAsync();
+        PublicarEstado();
+        return preparado.Info;
+    }
+
+    // lê o checkpoint inteiro para memória e ensaia cada seção em componentes descartáveis;
+    // qualquer defeito (truncamento, RAM de outro tamanho, seção corrompida) lança aqui
+    CheckpointPreparado PrepararCheckpoint(Stream origem)
+    {
+        Configuracoes? config = null;
+        byte[]? memoria = null;
+        var secoes = new List<(SecaoCheckpoint, byte[])>();
+
+        using var leitor = new LeitorCheckpoint(origem);
+        while (leitor.ProximaSecao(out var secao))
+        {
+            switch (secao)
+            {
+                case SecaoCheckpoint.Configuracao:
+                    try
+                    {
+                        config = JsonSerializer.Deserialize<Configuracoes>(leitor.LerSecao().ReadString())
+                            ?? throw new InvalidDataException("Configuração ausente no checkpoint.");
+                        config.Validate();
+                    }
+                    catch (Exception ex) when (ex is JsonException or ValidationException or EndOfStreamException)
+                    {
+                        throw new InvalidDataException($"Configuração inválida no checkpoint: {ex.Message}", ex);
+                    }
+                    break;
+                case SecaoCheckpoint.Ram:
+                    memoria = new byte[ram.TamanhoEmBytes];
+                    try
+                    {
+                        leitor.LerRam(memoria);
+                    }
+                    catch (EndOfStreamException)
+                    {
+                        throw new InvalidDataException("Checkpoint truncado na seção de RAM.");
+                    }
+                    break;
+                default:
+                    // seções desconhecidas (versões futuras) são ignoradas
+                    if (SecaoDeDispositivo(secao)) secoes.Add((secao, leitor.LerSecaoBruta()));
+                    break;
+            }
+        }
+
+        EnsaiarDispositivos(config ?? configAtiva, secoes);
+        return new CheckpointPreparado(config, memoria, secoes, leitor.Ciclo, leitor.Info);
+    }
+
+    static bool SecaoDeDispositivo(SecaoCheckpoint secao) => secao is SecaoCheckpoint.Cpu or SecaoCheckpoint.Metricas
+        or SecaoCheckpoint.Cache or SecaoCheckpoint.Pic or SecaoCheckpoint.Timer or SecaoCheckpoint.Dma or SecaoCheckpoint.DmaAgenda;
+
+    static BinaryReader LeitorSecao(byte[] dados) =>
+        new(new MemoryStream(dados, writable: false), Encoding.UTF8);
+
+    // restaura as seções em cópias descartáveis dos componentes (mesmos formatos, mesma ordem)
+    void EnsaiarDispositivos(Configuracoes config, List<(SecaoCheckpoint Secao, byte[] Dados)> secoes)
+    {
+        var agenda = new EventScheduler();
+        var picEnsaio = new PicController();
+        var metricas = new Metrics();
+        var cpu = new CpuSimulator(new RamState(1), picEnsaio, metricas, new CpuState());
+        var timerEnsaio = new DispositivoTimer(agenda, picEnsaio, 1);
+        var dma = new DmaState();
+        var dmaEnsaio = new DMA.DMA(ram, CriarMmio(config), dma, agenda);
+
+        foreach (var (secao, dados) in secoes)
+        {
+            try
+            {
+                var r = LeitorSecao(dados);
+                switch (secao)
+                {
+                    case SecaoCheckpoint.Cpu: cpu.RestaurarEstado(r); break;
+                    case SecaoCheckpoint.Metricas: RestaurarMetricas(metricas, r); break;
+                    case SecaoCheckpoint.Cache: CriarCache(config, null).RestaurarEstado(r); break;
+                    case SecaoCheckpoint.Pic: picEnsaio.RestaurarEstado(r); break;
+                    case SecaoCheckpoint.Timer: timerEnsaio.RestaurarEstado(r); break;
+                    case SecaoCheckpoint.Dma: dma.RestaurarEstado(r); break;
+                    case SecaoCheckpoint.DmaAgenda: dmaEnsaio.RestaurarAgenda(r); break;
+                }
+            }
+            catch (Exception ex) when (ex is IOException or ArgumentException or FormatException or DecoderFallbackException)
+            {
+                throw new InvalidDataException($"Seção {secao} do checkpoint inválida: {ex.Message}", ex);
+            }
+        }
+    }
+
+    static bool GeometriaCacheMudou(Configuracoes a, Configuracoes b) =>
+        ParseMemorySize(a.L1Size) != ParseMemorySize(b.L1Size)
+        || a.L1LineSize != b.L1LineSize
+        || a.L1Assoc != b.L1Assoc
+        || !string.Equals(a.L1WritePolicy, b.L1WritePolicy, StringComparison.OrdinalIgnoreCase);
+
+    static Cache.Cache CriarCache(Configuracoes cfg, CacheState? cacheState)
+    {
+        int cacheSizeBytes = ParseMemorySize(cfg.L1Size) ?? 16 * 1024;
+        int blockSize = Math.Max(1, cfg.L1LineSize);
+        int assoc = Math.Max(1, cfg.L1Assoc);
+        var wp = (cfg.L1WritePolicy ?? "WT").ToUpperInvariant() == "WT" ? WritePolicy.WriteThrough : WritePolicy.WriteBack;
+        // substituição fixa LRU para simplificação
+        return new Cache.Cache(cacheSizeBytes, blockSize, assoc, ReplacementPolicy.LRU, wp, cacheState);
+    }
+
+    DMA.DMA CriarDma(Configuracoes cfg)
+    {
+        var dma = new DMA.DMA(ram, mmio, dmaState, scheduler);
+        AjustarRajadasDma(dma, cfg);
+        return dma;
+    }
+
+    // custo de uma rajada no barramento: palavras da rajada × (1 + estados de espera)
+    static void AjustarRajadasDma(DMA.DMA dma, Configuracoes cfg)
+    {
+        int burst = Math.Max(1, cfg.DmaBurstLen);
+        int largura = Math.Max(1, cfg.BusWidthBytes);
+        dma.BytesPorRajada = burst;
+        dma.CiclosPorRajada = (burst + largura - 1) / largura * (1 + Math.Max(0, cfg.BusWaitStates));
+    }
+
+    static DispositivoMMIO CriarMmio(Configuracoes cfg)
+    {
+        uint dmaBase = cfg.DmaBase;
+        return new DispositivoMMIO((int)dmaBase, (int)(dmaBase + 0xFF)); // faixa simples
+    }
+
+    // tamanho "16KB", "1MB" ou em bytes; nulo se não reconhecido (Configuracoes.Validate rejeita)
+    internal static int? ParseMemorySize(string? s)
     {
         if (string.IsNullOrWhiteSpace(s)) return null;
         s = s.Trim().ToUpperInvariant();
@@ -145,8 +1343,77 @@ public class SimulationEngine : IDisposable
     public void Dispose()
     {
         StopAuto();
+        desempenho?.Dispose();
+        sinalParada.Dispose();
+        lock (execSync) { timer.Parar(); }
+        lock (execSync) { dispositivos.Dispose(); }
+        try { PararTrace(); } catch (IOException) { }
         // unsubscribes corretos usando os mesmos handlers registrados
         try { ram.MemoryChanged -= ramMemoryChangedHandler; } catch { }
         try { dmaState.StateChanged -= dmaStateChangedHandler; } catch { }
     }
 }
+
+/// <summary>
+/// Resultado de uma execução em lote: ciclos simulados, duração real e vazão obtida.
+/// </summary>
+public record RunResult(
+    long CiclosExecutados,
+    long InstrucoesExecutadas,
+    TimeSpan Duracao,
+    double CiclosPorSegundo,
+    double InstrucoesPorSegundo,
+    double NanossegundosPorCiclo,
+    bool CondicaoAtingida,
+    bool Cancelado
+)
+{
+    internal static RunResult Criar(long ciclos, long instrucoes, TimeSpan duracao, bool condicaoAtingida, bool cancelado)
+    {
+        double segundos = duracao.TotalSeconds;
+        return new RunResult(
+            CiclosExecutados: ciclos,
+            InstrucoesExecutadas: instrucoes,
+            Duracao: duracao,
+            CiclosPorSegundo: segundos > 0 ? ciclos / segundos : 0,
+            InstrucoesPorSegundo: segundos > 0 ? instrucoes / segundos : 0,
+            NanossegundosPorCiclo: ciclos > 0 ? duracao.TotalMilliseconds * 1_000_000.0 / ciclos : 0,
+            CondicaoAtingida: condicaoAtingida,
+            Cancelado: cancelado
+        );
+    }
+}
+
+/// <summary>
+/// Situação de um dispositivo paralelo (ver <see cref="SimulationEngine.ListarDispositivos"/>).
+/// </summary>
+public record InfoDispositivo(
+    int Indice,
+    string Nome,
+    string Tipo,
+    long LatenciaCiclos,
+    long CicloLocal,
+    string Resumo
+);
+
+/// <summary>
+/// Modos da thread automática: um ciclo por intervalo (legado), velocidade máxima,
+/// ou ritmo do relógio configurado (<see cref="Configuracoes.ClockHz"/>).
+/// </summary>
+public enum ModoExecucao
+{
+    Intervalo,
+    Maximo,
+    Relogio
+}
+
+/// <summary>
+/// O que foi reconstruído por <see cref="SimulationEngine.Reconfigurar"/>.
+/// </summary>
+public record ResultadoReconfiguracao(
+    bool CacheReconstruida,
+    int LinhasMigradas,
+    bool MmioReconstruido,
+    bool TimerReajustado,
+    string? Aviso
+);
@@ -1,4 +1,5 @@
-﻿using ProjetoSimuladorPC.Cache;
+﻿using System.Buffers;
+using ProjetoSimuladorPC.Cache;
 using ProjetoSimuladorPC.Cpu;
 using ProjetoSimuladorPC.DMA;
 using ProjetoSimuladorPC.RAM;
@@ -11,13 +12,24 @@ namespace ProjetoSimuladorPC.Utilidades
     /// </summary>
     public class SimulationState
     {
-        private readonly object _sync = new();
+        // construção de snapshots (nunca disputado pelo motor)
+        private readonly object _construcao = new();
+
+        // quadro de estado publicado pelo motor nas fronteiras de lote: seqlock com um único
+        // escritor (ímpar = gravação em andamento; 0 = nenhum quadro ainda)
+        private long _seqQuadro;
+        private QuadroEstado _quadro;
 
         // Configurações fixas (YAML)
         public Configuracoes Config { get; set; } = new Configuracoes();
 
-        // Controle do clock
-        public long CicloAtual { get; set; } = 0;
+        // Controle do clock: escrito só pela thread que executa os ciclos (sob o execSync do motor)
+        private long _cicloAtual;
+        public long CicloAtual
+        {
+            get => Volatile.Read(ref _cicloAtual);
+            set => Volatile.Write(ref _cicloAtual, value);
+        }
 
         // Estados dos módulos (existem em suas pastas)
         public CpuState Cpu { get; set; } = new CpuState();
@@ -28,111 +40,297 @@ namespace ProjetoSimuladorPC.Utilidades
         // Evento para notificar UI sobre mudança no estado (ex.: Blazor components podem assinar)
         public event EventHandler? StateChanged;
 
+        // Último snapshot publicado pelo motor (troca sem lock; leitores nunca bloqueiam a simulação)
+        private SimulationSnapshot? _publicado;
+
+        /// <summary>
+        /// Snapshot imutável mais recente publicado pela thread de simulação, ou null.
+        /// </summary>
+        public SimulationSnapshot? PublishedSnapshot => Volatile.Read(ref _publicado);
+
+        /// <summary>
+        /// Publica um snapshot (troca atômica da referência) e notifica assinantes.
+        /// O snapshot passa a valer para a versão criada por esta publicação, desde que nenhuma
+        /// outra mudança tenha sido notificada entre sua construção e a publicação.
+        /// </summary>
+        public void PublishSnapshot(SimulationSnapshot snapshot)
+        {
+            if (snapshot is null) throw new ArgumentNullException(nameof(snapshot));
+
+            long versao = Interlocked.Increment(ref _versao);
+            if (versao == snapshot.Versao + 1) snapshot = snapshot with { Versao = versao };
+            Volatile.Write(ref _publicado, snapshot);
+            StateChanged?.Invoke(this, EventArgs.Empty);
+        }
+
         /// <summary>
         /// Dispara o evento StateChanged de forma thread-safe.
         /// Use quando alguma atualização importante ocorrer (tick, acesso, escrita etc.).
         /// </summary>
         public void NotifyStateChanged()
         {
+            Interlocked.Increment(ref _versao);
             StateChanged?.Invoke(this, EventArgs.Empty);
         }
 
+        private long _versao;
+
+        // partes do último snapshot construído (sob _construcao): reaproveitadas, sem alocar, quando não mudaram
+        private CpuSnapshot? _cpuAnterior;
+        private CacheSnapshot? _cacheAnterior;
+        private RamSnapshot? _ramAnterior;
+
+        /// <summary>
+        /// Versão do estado: incrementada a cada notificação. Consumidores por amostragem
+        /// (ex.: streaming) comparam versões para não reconstruir snapshots sem mudanças.
+        /// </summary>
+        public long Versao => Interlocked.Read(ref _versao);
+
         /// <summary>
         /// Atualiza o ciclo atual e notifica assinantes.
         /// </summary>
         public void AdvanceCycle(long delta = 1)
         {
-            lock (_sync)
-            {
-                CicloAtual += delta;
-            }
+            Interlocked.Add(ref _cicloAtual, delta);
             NotifyStateChanged();
         }
 
         /// <summary>
-        /// Retorna um snapshot imutável e pequeno do estado do simulador pronto para renderização na UI.
-        /// RamPreviewLength limita a quantidade de bytes lidos da RAM para evitar snapshots enormes.
+        /// Atualiza o ciclo atual sem notificar assinantes (uso do motor em execuções em lote,
+        /// que publicam uma única notificação ao final). Sem lock: o motor é o único escritor e
+        /// chama isto a cada ciclo quando há condição de parada.
         /// </summary>
-        public SimulationSnapshot GetSnapshot(int ramPreviewAddress = 0, int ramPreviewLength = 16)
+        public void AdvanceCycleSilently(long delta) => Volatile.Write(ref _cicloAtual, _cicloAtual + delta);
+
+        /// <summary>
+        /// Grava um quadro completo (ciclo, CPU, contadores da cache, DMA e configuração) para os
+        /// leitores de <see cref="GetSnapshot"/>. Chamado pelo motor com a simulação parada numa
+        /// fronteira de ciclo; não bloqueia nem aloca. <paramref name="dma"/> nulo indica DMA fora
+        /// da linha do tempo dos ciclos (transferência assíncrona), lida ao vivo.
+        /// </summary>
+        internal void PublicarQuadro(ContadoresCache cache, DmaSnapshot? dma, Configuracoes config)
         {
-            lock (_sync)
+            var c = Cpu;
+            var quadro = new QuadroEstado
             {
-                // CPU snapshot
-                var cpu = new CpuSnapshot(
-                    ContadorPrograma: Cpu.ContadorPrograma,
-                    Acumulador: Cpu.Acumulador,
-                    InterrupcaoHabilitada: Cpu.InterrupcaoHabilitada,
-                    Parado: Cpu.Parado,
-                    UltimoEnderecoAcesso: Cpu.UltimoEnderecoAcesso,
-                    UltimoDadoLido: Cpu.UltimoDadoLido,
-                    UltimoDadoEscrito: Cpu.UltimoDadoEscrito,
-                    OperacaoAtual: Cpu.OperacaoAtual ?? string.Empty
-                );
+                Ciclo = CicloAtual,
+                ContadorPrograma = c.ContadorPrograma,
+                Acumulador = c.Acumulador,
+                InterrupcaoHabilitada = c.InterrupcaoHabilitada,
+                Parado = c.Parado,
+                UltimoEnderecoAcesso = c.UltimoEnderecoAcesso,
+                UltimoDadoLido = c.UltimoDadoLido,
+                UltimoDadoEscrito = c.UltimoDadoEscrito,
+                OperacaoAtual = c.OperacaoAtual ?? string.Empty,
+                Cache = cache,
+                Dma = dma,
+                Config = config
+            };
 
-                // Cache snapshot (cópia simples dos campos essenciais)
-                var cache = new CacheSnapshot(
-                    Reads: Cache.Reads,
-                    Writes: Cache.Writes,
-                    Hits: Cache.Hits,
-                    Misses: Cache.Misses,
-                    MemoryWrites: Cache.MemoryWrites,
-                    CacheSizeBytes: Cache.CacheSizeBytes,
-                    BlockSizeBytes: Cache.BlockSizeBytes,
-                    Associativity: Cache.Associativity,
-                    NumSets: Cache.NumSets,
-                    ReplacementPolicy: Cache.ReplacementPolicy ?? string.Empty,
-                    WritePolicy: Cache.WritePolicy ?? string.Empty,
-                    HitRate: Cache.HitRate,
-                    MissRate: Cache.MissRate
-                );
+            // primeiro quadro: parte de 0 (sem quadro) para 2
+            Interlocked.Increment(ref _seqQuadro);
+            _quadro = quadro;
+            Interlocked.Increment(ref _seqQuadro);
+        }
 
-                // RAM preview — tenta ler, respeitando limites
-                byte[] ramPreview = Array.Empty<byte>();
-                bool ramPreviewOk = false;
-                try
+        // último quadro publicado, sem lock (repete se o motor estiver gravando); falso se não houver
+        private bool LerQuadro(out QuadroEstado quadro)
+        {
+            var espera = new SpinWait();
+            while (true)
+            {
+                long seq = Volatile.Read(ref _seqQuadro);
+                if (seq == 0)
                 {
-                    if (ramPreviewLength > 0)
-                    {
-                        if (ramPreviewAddress < 0) ramPreviewAddress = 0;
-                        if (ramPreviewAddress + ramPreviewLength > Ram.TamanhoEmBytes)
-                        {
-                            ramPreviewLength = Math.Max(0, Ram.TamanhoEmBytes - ramPreviewAddress);
-                        }
-
-                        if (ramPreviewLength > 0 && Ram.TryLer(ramPreviewAddress, ramPreviewLength, out var dados))
-                        {
-                            ramPreview = dados;
-                            ramPreviewOk = true;
-                        }
-                    }
+                    quadro = default;
+                    return false;
                 }
-                catch
+                if ((seq & 1) == 0)
                 {
-                    // fallback: preview stays empty
+                    quadro = _quadro;
+                    Interlocked.MemoryBarrier();
+                    if (Volatile.Read(ref _seqQuadro) == seq) return true;
                 }
+                espera.SpinOnce();
+            }
+        }
 
-                var ram = new RamSnapshot(
-                    TamanhoEmBytes: Ram.TamanhoEmBytes,
-                    TamanhoEmMB: Ram.TamanhoEmMB,
-                    PreviewAddress: ramPreviewAddress,
-                    Preview: ramPreview,
-                    PreviewAvailable: ramPreviewOk
-                );
+        // estado atual lido diretamente das fachadas (sem motor publicando quadros)
+        private QuadroEstado LerAoVivo()
+        {
+            var c = Cpu;
+            return new QuadroEstado
+            {
+                Ciclo = CicloAtual,
+                ContadorPrograma = c.ContadorPrograma,
+                Acumulador = c.Acumulador,
+                InterrupcaoHabilitada = c.InterrupcaoHabilitada,
+                Parado = c.Parado,
+                UltimoEnderecoAcesso = c.UltimoEnderecoAcesso,
+                UltimoDadoLido = c.UltimoDadoLido,
+                UltimoDadoEscrito = c.UltimoDadoEscrito,
+                OperacaoAtual = c.OperacaoAtual ?? string.Empty,
+                Cache = Cache.LerContadores(),
+                Config = Config
+            };
+        }
 
-                // DMA snapshot (usar o snapshot fornecido pela DmaState)
-                var dmaSnapshot = Dma.GetSnapshot();
+        /// <summary>
+        /// Retorna um snapshot imutável e pequeno do estado do simulador pronto para renderização na UI.
+        /// RamPreviewLength limita a quantidade de bytes lidos da RAM para evitar snapshots enormes.
+        /// Com um motor ligado, ciclo, CPU, cache e DMA vêm todos do último quadro publicado (mesmo
+        /// ciclo, sem esperar a simulação); só o preview da RAM é lido no momento da chamada.
+        /// </summary>
+        public SimulationSnapshot GetSnapshot(int ramPreviewAddress = 0, int ramPreviewLength = 16)
+        {
+            long inicio = SimuladorEventSource.Log.IsEnabled() ? System.Diagnostics.Stopwatch.GetTimestamp() : 0;
+            try
+            {
+                return ConstruirSnapshot(ramPreviewAddress, ramPreviewLength);
+            }
+            finally
+            {
+                if (inicio != 0)
+                    SimuladorEventSource.Log.SnapshotConstruido(System.Diagnostics.Stopwatch.GetElapsedTime(inicio).TotalMilliseconds);
+            }
+        }
+
+        private SimulationSnapshot ConstruirSnapshot(int ramPreviewAddress, int ramPreviewLength)
+        {
+            // versão lida antes da cópia: mudanças concorrentes tornam o snapshot obsoleto, nunca "adiantado"
+            long versao = Versao;
+            var quadro = LerQuadro(out var publicado) ? publicado : LerAoVivo();
+
+            lock (_construcao)
+            {
+                var cpu = SnapshotCpu(quadro);
+                var cache = SnapshotCache(quadro.Cache);
+                var ram = SnapshotRam(ramPreviewAddress, ramPreviewLength);
+
+                // DMA do quadro ou, se assíncrono, da DmaState (que reaproveita o snapshot entre mudanças)
+                var dmaSnapshot = quadro.Dma ?? Dma.GetSnapshot();
 
                 return new SimulationSnapshot(
-                    CicloAtual: CicloAtual,
+                    CicloAtual: quadro.Ciclo,
                     TimestampUtc: DateTime.UtcNow,
                     Cpu: cpu,
                     Cache: cache,
                     Ram: ram,
                     Dma: dmaSnapshot,
-                    Config: Config
+                    Config: quadro.Config,
+                    Versao: versao
                 );
             }
         }
+
+        // chamados sob _construcao
+        private CpuSnapshot SnapshotCpu(in QuadroEstado q)
+        {
+            if (_cpuAnterior is { } a
+                && a.ContadorPrograma == q.ContadorPrograma && a.Acumulador == q.Acumulador
+                && a.InterrupcaoHabilitada == q.InterrupcaoHabilitada && a.Parado == q.Parado
+                && a.UltimoEnderecoAcesso == q.UltimoEnderecoAcesso && a.UltimoDadoLido == q.UltimoDadoLido
+                && a.UltimoDadoEscrito == q.UltimoDadoEscrito && string.Equals(a.OperacaoAtual, q.OperacaoAtual, StringComparison.Ordinal))
+                return a;
+
+            return _cpuAnterior = new CpuSnapshot(
+                ContadorPrograma: q.ContadorPrograma,
+                Acumulador: q.Acumulador,
+                InterrupcaoHabilitada: q.InterrupcaoHabilitada,
+                Parado: q.Parado,
+                UltimoEnderecoAcesso: q.UltimoEnderecoAcesso,
+                UltimoDadoLido: q.UltimoDadoLido,
+                UltimoDadoEscrito: q.UltimoDadoEscrito,
+                OperacaoAtual: q.OperacaoAtual
+            );
+        }
+
+        private CacheSnapshot SnapshotCache(ContadoresCache n)
+        {
+            var c = Cache;
+            string repl = c.ReplacementPolicy ?? string.Empty, write = c.WritePolicy ?? string.Empty;
+            if (_cacheAnterior is { } a
+                && a.Reads == n.Reads && a.Writes == n.Writes && a.Hits == n.Hits && a.Misses == n.Misses
+                && a.MemoryWrites == n.MemoryWrites && a.CacheSizeBytes == c.CacheSizeBytes
+                && a.BlockSizeBytes == c.BlockSizeBytes && a.Associativity == c.Associativity && a.NumSets == c.NumSets
+                && string.Equals(a.ReplacementPolicy, repl, StringComparison.Ordinal)
+                && string.Equals(a.WritePolicy, write, StringComparison.Ordinal))
+                return a;
+
+            return _cacheAnterior = new CacheSnapshot(
+                Reads: n.Reads,
+                Writes: n.Writes,
+                Hits: n.Hits,
+                Misses: n.Misses,
+                MemoryWrites: n.MemoryWrites,
+                CacheSizeBytes: c.CacheSizeBytes,
+                BlockSizeBytes: c.BlockSizeBytes,
+                Associativity: c.Associativity,
+                NumSets: c.NumSets,
+                ReplacementPolicy: repl,
+                WritePolicy: write,
+                HitRate: n.HitRate,
+                MissRate: n.MissRate
+            );
+        }
+
+        // RAM preview — leitura sem cache (observar não altera hits/misses), respeitando limites.
+        // Lida num buffer do pool; só aloca um novo array se o conteúdo mudou desde o último preview.
+        private RamSnapshot SnapshotRam(int ramPreviewAddress, int ramPreviewLength)
+        {
+            int tamanhoRam = Ram.TamanhoEmBytes;
+            if (ramPreviewAddress < 0) ramPreviewAddress = 0;
+            if (ramPreviewLength < 0 || ramPreviewAddress >= tamanhoRam) ramPreviewLength = 0;
+            else if ((long)ramPreviewAddress + ramPreviewLength > tamanhoRam) ramPreviewLength = tamanhoRam - ramPreviewAddress;
+
+            if (ramPreviewLength == 0)
+            {
+                if (_ramAnterior is { PreviewAvailable: false } vazio && vazio.PreviewAddress == ramPreviewAddress
+                    && vazio.TamanhoEmBytes == tamanhoRam)
+                    return vazio;
+                return _ramAnterior = new RamSnapshot(tamanhoRam, Ram.TamanhoEmMB, ramPreviewAddress, Array.Empty<byte>(), false);
+            }
+
+            var buffer = ArrayPool<byte>.Shared.Rent(ramPreviewLength);
+            try
+            {
+                var atual = buffer.AsSpan(0, ramPreviewLength);
+                Ram.Espiar(ramPreviewAddress, atual);
+
+                if (_ramAnterior is { PreviewAvailable: true } a && a.PreviewAddress == ramPreviewAddress
+                    && a.TamanhoEmBytes == tamanhoRam && atual.SequenceEqual(a.Preview))
+                    return a;
+
+                return _ramAnterior = new RamSnapshot(
+                    TamanhoEmBytes: tamanhoRam,
+                    TamanhoEmMB: Ram.TamanhoEmMB,
+                    PreviewAddress: ramPreviewAddress,
+                    Preview: atual.ToArray(),
+                    PreviewAvailable: true
+                );
+            }
+            finally
+            {
+                ArrayPool<byte>.Shared.Return(buffer);
+            }
+        }
+    }
+
+    // quadro de estado gravado pelo motor (ver SimulationState.PublicarQuadro)
+    internal struct QuadroEstado
+    {
+        public long Ciclo;
+        public int ContadorPrograma;
+        public uint Acumulador;
+        public bool InterrupcaoHabilitada;
+        public bool Parado;
+        public int UltimoEnderecoAcesso;
+        public uint UltimoDadoLido;
+        public uint UltimoDadoEscrito;
+        public string OperacaoAtual;
+        public ContadoresCache Cache;
+        public DmaSnapshot? Dma;
+        public Configuracoes Config;
     }
 
     // --- Snapshot / DTO records usados pela UI (imutáveis e simples) ---
@@ -144,7 +342,8 @@ namespace ProjetoSimuladorPC.Utilidades
         CacheSnapshot Cache,
         RamSnapshot Ram,
         DmaSnapshot Dma,
-        Configuracoes Config
+        Configuracoes Config,
+        long Versao = 0
     );
 
     public record CpuSnapshot(
@@ -0,0 +1,66 @@
+using System.Text.Json;
+using System.Text.Json.Nodes;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Codificação delta de snapshots no formato JSON Merge Patch (RFC 7386): apenas os campos
+    /// alterados em relação ao snapshot anterior são enviados; objetos aninhados são comparados
+    /// campo a campo e arrays/valores são substituídos por inteiro.
+    /// </summary>
+    public static class SnapshotDelta
+    {
+        /// <summary>
+        /// Opções de serialização (mesmas convenções da API: camelCase).
+        /// </summary>
+        public static readonly JsonSerializerOptions Opcoes = new(JsonSerializerDefaults.Web);
+
+        public static JsonObject ParaJson(SimulationSnapshot snapshot) =>
+            JsonSerializer.SerializeToNode(snapshot, Opcoes)!.AsObject();
+
+        /// <summary>
+        /// Retorna o patch que transforma <paramref name="anterior"/> em <paramref name="atual"/>,
+        /// ou null se não houver diferenças.
+        /// </summary>
+        public static JsonObject? Diff(JsonObject anterior, JsonObject atual)
+        {
+            JsonObject? patch = null;
+
+            foreach (var (nome, valor) in atual)
+            {
+                anterior.TryGetPropertyValue(nome, out var antigo);
+
+                JsonNode? mudanca;
+                bool mudou;
+                if (valor is JsonObject objAtual && antigo is JsonObject objAntigo)
+                {
+                    mudanca = Diff(objAntigo, objAtual);
+                    mudou = mudanca is not null;
+                }
+                else
+                {
+                    mudou = !JsonNode.DeepEquals(antigo, valor);
+                    mudanca = valor?.DeepClone();
+                }
+
+                if (mudou)
+                {
+                    patch ??= new JsonObject();
+                    patch[nome] = mudanca;
+                }
+            }
+
+            // campos removidos viram null (semântica de merge patch)
+            foreach (var (nome, _) in anterior)
+            {
+                if (!atual.ContainsKey(nome))
+                {
+                    patch ??= new JsonObject();
+                    patch[nome] = null;
+                }
+            }
+
+            return patch;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+using System;
+using System.Threading;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Fonte única de snapshots em processo para a UI (Blazor) e a API REST.
+    /// Cada versão de <see cref="SimulationState"/> é copiada uma única vez por janela de preview
+    /// da RAM; todos os circuitos e requisições recebem a mesma instância imutável.
+    /// O snapshot publicado pela thread de simulação é reaproveitado quando corresponde à versão atual.
+    /// </summary>
+    public sealed class SnapshotService
+    {
+        /// <summary>
+        /// Janela de preview padrão (a mesma publicada pelo motor).
+        /// </summary>
+        public const int PreviewPadrao = 32;
+
+        // poucas janelas distintas em uso ao mesmo tempo (painel, API, streaming)
+        const int Entradas = 8;
+
+        sealed record Entrada(int Endereco, int Tamanho, SimulationSnapshot Snapshot);
+
+        readonly SimulationState sim;
+        readonly Entrada?[] cache = new Entrada?[Entradas];
+        readonly object construcao = new();
+        long construidos;
+
+        public SnapshotService(SimulationState sim)
+        {
+            this.sim = sim ?? throw new ArgumentNullException(nameof(sim));
+        }
+
+        /// <summary>
+        /// Quantidade de snapshots efetivamente construídos (os demais pedidos foram atendidos pelo cache).
+        /// </summary>
+        public long Construidos => Interlocked.Read(ref construidos);
+
+        /// <summary>
+        /// Snapshot da versão atual com o preview padrão da RAM.
+        /// </summary>
+        public SimulationSnapshot Obter() => Obter(0, PreviewPadrao);
+
+        /// <summary>
+        /// Snapshot da versão atual para a janela de preview informada. Leituras concorrentes
+        /// da mesma versão não bloqueiam; apenas a primeira constrói o snapshot.
+        /// </summary>
+        public SimulationSnapshot Obter(int ramPreviewAddress, int ramPreviewLength)
+        {
+            if (ramPreviewAddress < 0) ramPreviewAddress = 0;
+            if (ramPreviewLength < 0) ramPreviewLength = 0;
+
+            long versao = sim.Versao;
+
+            if (ramPreviewAddress == 0 && ramPreviewLength == PreviewPadrao
+                && sim.PublishedSnapshot is { } publicado && publicado.Versao == versao)
+                return publicado;
+
+            if (Procurar(ramPreviewAddress, ramPreviewLength, versao) is { } pronto)
+                return pronto;
+
+            lock (construcao)
+            {
+                // outro leitor pode ter construído enquanto esperávamos
+                versao = sim.Versao;
+                if (Procurar(ramPreviewAddress, ramPreviewLength, versao) is { } construido)
+                    return construido;
+
+                var snap = sim.GetSnapshot(ramPreviewAddress, ramPreviewLength);
+                Interlocked.Increment(ref construidos);
+                Guardar(new Entrada(ramPreviewAddress, ramPreviewLength, snap));
+                return snap;
+            }
+        }
+
+        SimulationSnapshot? Procurar(int endereco, int tamanho, long versao)
+        {
+            for (int i = 0; i < cache.Length; i++)
+            {
+                var e = Volatile.Read(ref cache[i]);
+                if (e is not null && e.Endereco == endereco && e.Tamanho == tamanho && e.Snapshot.Versao == versao)
+                    return e.Snapshot;
+            }
+            return null;
+        }
+
+        // chamado sob o lock: substitui a mesma janela ou, na falta dela, a entrada mais antiga
+        void Guardar(Entrada nova)
+        {
+            int alvo = 0;
+            long menorVersao = long.MaxValue;
+            for (int i = 0; i < cache.Length; i++)
+            {
+                var e = cache[i];
+                if (e is null || (e.Endereco == nova.Endereco && e.Tamanho == nova.Tamanho))
+                {
+                    alvo = i;
+                    break;
+                }
+                if (e.Snapshot.Versao < menorVersao)
+                {
+                    menorVersao = e.Snapshot.Versao;
+                    alvo = i;
+                }
+            }
+            Volatile.Write(ref cache[alvo], nova);
+        }
+    }
+}
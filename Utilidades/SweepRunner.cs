@@ -0,0 +1,210 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+using System.Text.Json;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace ProjetoSimuladorPC.Utilidades
+{
+    /// <summary>
+    /// Carga de trabalho de um experimento: orçamento de ciclos e, opcionalmente, uma imagem
+    /// carregada na RAM antes da execução.
+    /// </summary>
+    public record CargaTrabalho(string Nome, long Ciclos, byte[]? Imagem = null, int EnderecoCarga = 0);
+
+    /// <summary>
+    /// Uma variante de configuração a ser executada na varredura.
+    /// </summary>
+    public record VariacaoSweep(string Nome, Configuracoes Config);
+
+    /// <summary>
+    /// Linha da tabela de resultados de uma varredura.
+    /// </summary>
+    public record ResultadoSweep(
+        string Nome,
+        string L1Size,
+        int L1Assoc,
+        int L1LineSize,
+        string L1WritePolicy,
+        int TimerPeriodCycles,
+        long Ciclos,
+        long Instrucoes,
+        double DuracaoMs,
+        double CiclosPorSegundo,
+        ulong Reads,
+        ulong Writes,
+        ulong Hits,
+        ulong Misses,
+        ulong MemoryWrites,
+        double HitRate,
+        long EventosTimer,
+        string? Erro
+    );
+
+    /// <summary>
+    /// Executor headless de varreduras de parâmetros: cada variante roda numa instância isolada
+    /// de <see cref="SimulationState"/> + <see cref="SimulationEngine"/>, em paralelo sobre
+    /// todos os núcleos do host, e os resultados são exportados em CSV ou JSON.
+    /// </summary>
+    public static class SweepRunner
+    {
+        /// <summary>
+        /// Produto cartesiano dos eixos informados sobre <paramref name="baseConfig"/>.
+        /// Eixos nulos ou vazios mantêm o valor da configuração base. Lança
+        /// <see cref="ArgumentException"/> se um tamanho de <paramref name="l1Sizes"/> não for reconhecido.
+        /// </summary>
+        public static IReadOnlyList<VariacaoSweep> Grade(
+            Configuracoes baseConfig,
+            IEnumerable<string>? l1Sizes = null,
+            IEnumerable<int>? l1Assocs = null,
+            IEnumerable<int>? l1LineSizes = null,
+            IEnumerable<string>? l1WritePolicies = null,
+            IEnumerable<int>? timerPeriods = null)
+        {
+            if (baseConfig is null) throw new ArgumentNullException(nameof(baseConfig));
+            foreach (var size in l1Sizes ?? Enumerable.Empty<string>())
+            {
+                if (SimulationEngine.ParseMemorySize(size) is not > 0)
+                    throw new ArgumentException($"L1Sizes contém um tamanho inválido: '{size}'.");
+            }
+
+            static IReadOnlyList<T> Eixo<T>(IEnumerable<T>? valores, T padrao)
+            {
+                var lista = valores?.ToList();
+                return lista is { Count: > 0 } ? lista : new List<T> { padrao };
+            }
+
+            var variacoes = new List<VariacaoSweep>();
+            foreach (var size in Eixo(l1Sizes, baseConfig.L1Size))
+            foreach (var assoc in Eixo(l1Assocs, baseConfig.L1Assoc))
+            foreach (var line in Eixo(l1LineSizes, baseConfig.L1LineSize))
+            foreach (var wp in Eixo(l1WritePolicies, baseConfig.L1WritePolicy))
+            foreach (var period in Eixo(timerPeriods, baseConfig.TimerPeriodCycles))
+            {
+                var cfg = baseConfig.Clone();
+                cfg.L1Size = size;
+                cfg.L1Assoc = assoc;
+                cfg.L1LineSize = line;
+                cfg.L1WritePolicy = wp;
+                cfg.TimerPeriodCycles = period;
+                variacoes.Add(new VariacaoSweep($"{size}-a{assoc}-l{line}-{wp}-t{period}", cfg));
+            }
+            return variacoes;
+        }
+
+        /// <summary>
+        /// Executa todas as variantes com <see cref="Parallel.ForEachAsync"/>. O resultado preserva
+        /// a ordem de entrada; falhas de configuração viram linhas com <see cref="ResultadoSweep.Erro"/>.
+        /// Cancelar <paramref name="ct"/> não lança: as variantes em andamento param no próximo lote
+        /// e as restantes voltam como linhas "cancelado", preservando os resultados parciais.
+        /// </summary>
+        public static async Task<IReadOnlyList<ResultadoSweep>> ExecutarAsync(
+            IReadOnlyList<VariacaoSweep> variacoes,
+            CargaTrabalho carga,
+            int? paralelismo = null,
+            CancellationToken ct = default)
+        {
+            if (variacoes is null) throw new ArgumentNullException(nameof(variacoes));
+            if (carga is null) throw new ArgumentNullException(nameof(carga));
+
+            var resultados = new ResultadoSweep[variacoes.Count];
+            // o token vai só para RunCycles (não para ParallelOptions, que abortaria a tabela inteira)
+            var opcoes = new ParallelOptions
+            {
+                MaxDegreeOfParallelism = Math.Max(1, paralelismo ?? Environment.ProcessorCount)
+            };
+
+            await Parallel.ForEachAsync(Enumerable.Range(0, variacoes.Count), opcoes, (i, _) =>
+            {
+                resultados[i] = ExecutarVariacao(variacoes[i], carga, ct);
+                return ValueTask.CompletedTask;
+            }).ConfigureAwait(false);
+
+            return resultados;
+        }
+
+        /// <summary>
+        /// Executa uma única variante numa máquina isolada (síncrono, na thread chamadora).
+        /// </summary>
+        public static ResultadoSweep ExecutarVariacao(VariacaoSweep variacao, CargaTrabalho carga, CancellationToken ct = default)
+        {
+            var cfg = variacao.Config;
+            try
+            {
+                cfg.Validate();
+
+                var state = new SimulationState { Config = cfg.Clone() };
+
+                // a imagem é carregada antes do motor anexar a cache (não conta nas estatísticas)
+                if (carga.Imagem is { Length: > 0 })
+                    state.Ram.Escrever(carga.EnderecoCarga, carga.Imagem);
+
+                using var engine = new SimulationEngine(state);
+                var run = engine.RunCycles(carga.Ciclos, ct);
+                var cache = state.Cache;
+
+                return new ResultadoSweep(
+                    Nome: variacao.Nome,
+                    L1Size: cfg.L1Size,
+                    L1Assoc: cfg.L1Assoc,
+                    L1LineSize: cfg.L1LineSize,
+                    L1WritePolicy: cfg.L1WritePolicy,
+                    TimerPeriodCycles: cfg.TimerPeriodCycles,
+                    Ciclos: run.CiclosExecutados,
+                    Instrucoes: run.InstrucoesExecutadas,
+                    DuracaoMs: run.Duracao.TotalMilliseconds,
+                    CiclosPorSegundo: run.CiclosPorSegundo,
+                    Reads: cache.Reads,
+                    Writes: cache.Writes,
+                    Hits: cache.Hits,
+                    Misses: cache.Misses,
+                    MemoryWrites: cache.MemoryWrites,
+                    HitRate: cache.HitRate,
+                    EventosTimer: engine.Timer.EventosGerados,
+                    Erro: run.Cancelado ? "cancelado" : null
+                );
+            }
+            catch (Exception ex) when (ex is ArgumentException or System.ComponentModel.DataAnnotations.ValidationException)
+            {
+                return new ResultadoSweep(variacao.Nome, cfg.L1Size, cfg.L1Assoc, cfg.L1LineSize, cfg.L1WritePolicy,
+                    cfg.TimerPeriodCycles, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ex.Message);
+            }
+        }
+
+        /// <summary>
+        /// Escreve a tabela de resultados em CSV (cultura invariante, cabeçalho na primeira linha).
+        /// </summary>
+        public static void EscreverCsv(TextWriter saida, IEnumerable<ResultadoSweep> resultados)
+        {
+            var inv = CultureInfo.InvariantCulture;
+            saida.WriteLine("nome,l1_size,l1_assoc,l1_line,l1_write_policy,timer_period,ciclos,instrucoes,duracao_ms,ciclos_por_s,reads,writes,hits,misses,memory_writes,hit_rate,eventos_timer,erro");
+            foreach (var r in resultados)
+            {
+                saida.WriteLine(string.Join(",",
+                    Csv(r.Nome), Csv(r.L1Size), r.L1Assoc.ToString(inv), r.L1LineSize.ToString(inv), Csv(r.L1WritePolicy),
+                    r.TimerPeriodCycles.ToString(inv), r.Ciclos.ToString(inv), r.Instrucoes.ToString(inv),
+                    r.DuracaoMs.ToString("F3", inv), r.CiclosPorSegundo.ToString("F0", inv),
+                    r.Reads.ToString(inv), r.Writes.ToString(inv), r.Hits.ToString(inv), r.Misses.ToString(inv),
+                    r.MemoryWrites.ToString(inv), r.HitRate.ToString("F6", inv), r.EventosTimer.ToString(inv),
+                    Csv(r.Erro ?? string.Empty)));
+            }
+        }
+
+        /// <summary>
+        /// Escreve a tabela de resultados como um array JSON.
+        /// </summary>
+        public static Task EscreverJsonAsync(Stream saida, IEnumerable<ResultadoSweep> resultados, CancellationToken ct = default)
+        {
+            return JsonSerializer.SerializeAsync(saida, resultados, new JsonSerializerOptions { WriteIndented = true }, ct);
+        }
+
+        static string Csv(string valor)
+        {
+            if (valor.IndexOfAny(new[] { ',', '"', '\n', '\r' }) < 0) return valor;
+            return "\"" + valor.Replace("\"", "\"\"") + "\"";
+        }
+    }
+}